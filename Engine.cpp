@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Engine.h"
+#include "OpeningBook.h"
+
+namespace {
+
+    constexpr int g_pawnValue = 100;
+    constexpr int g_queenValue = 300;
+
+}
+
+Engine::Engine(nnue::Network const * network, OpeningBook const * book) : m_network(network), m_book(book) {}
+
+std::optional<Game::Move> Engine::getBestMove(Game const & game, int depth) const {
+    if (m_book != nullptr) {
+        auto move = m_book->getMove(game);
+        if (move) return move;
+    }
+    auto lines = analyse(game, depth, 1);
+    if (lines.empty()) return std::nullopt;
+    return lines.front().move;
+}
+
+int Engine::search(Game const & game, int depth) const {
+    auto accumulator = createAccumulator(game);
+    auto pv = std::vector<Game::Move>();
+    return negamax(game, accumulator ? &*accumulator : nullptr, depth, -g_winScore - 1, g_winScore + 1, 0, pv);
+}
+
+std::vector<Engine::Line> Engine::analyse(Game const & game, int depth, int lines) const {
+    auto result = std::vector<Line>();
+    auto moves = game.getMoves();
+    if (lines <= 0 || moves.empty()) return result;
+    auto accumulator = createAccumulator(game);
+    auto mover = game.getCurrentPlayer();
+
+    for (auto const & move : moves) {
+        // Once the lines are full, a null window above the worst kept line only proves the move worse,
+        // and just the moves beating it are searched again for the exact score
+        auto isFull = result.size() == static_cast<std::size_t>(lines);
+        auto alpha = isFull ? result.back().score : -g_winScore - 1;
+        auto child = game;
+        auto processed = child.process(move.from, move.to);
+        auto pv = std::vector<Game::Move>();
+        auto node = accumulator ? &*accumulator : nullptr;
+        if (isFull && searchChild(child, processed, move, mover, node, depth, alpha, alpha + 1, 0, pv) <= alpha)
+            continue;
+        pv.clear();
+        auto score = searchChild(child, processed, move, mover, node, depth, alpha, g_winScore + 1, 0, pv);
+
+        pv.insert(pv.begin(), move);
+        auto position = std::ranges::upper_bound(result, score, std::ranges::greater(), &Line::score);
+        result.insert(position, Line{move, score, std::move(pv)});
+        if (result.size() > static_cast<std::size_t>(lines)) result.pop_back();
+    }
+    return result;
+}
+
+std::vector<Engine::Annotation> Engine::annotate(Game const & start, std::vector<Game::Move> const & moves,
+                                                 int depth, int threads) const {
+    // Replaying is sequential, only the searches of the positions run in parallel
+    auto annotations = std::vector<Annotation>();
+    auto positions = std::vector<Game>();
+    auto game = start;
+    for (auto const & move : moves) {
+        auto annotation = Annotation{move, move, 0, 0, 0, false};
+        if (!game.hasPosition(move.from) || !game.hasPosition(move.to) || !game.check(move.from, move.to).isCorrect) {
+            annotations.push_back(annotation);
+            break;
+        }
+        annotation.isCorrect = true;
+        annotations.push_back(annotation);
+        positions.push_back(game);
+        if (game.process(move.from, move.to).winner != Game::Player::None) break;
+    }
+
+    auto next = std::atomic<std::size_t>(0);
+    auto work = [&]{
+        for (auto i = next++; i < positions.size(); i = next++) {
+            auto const & position = positions[i];
+            auto & annotation = annotations[i];
+            auto lines = analyse(position, depth, 1);
+            annotation.best = lines.front().move;
+            annotation.bestScore = lines.front().score;
+            if (annotation.best.from == annotation.move.from && annotation.best.to == annotation.move.to)
+                annotation.playedScore = annotation.bestScore;
+            else {
+                auto accumulator = createAccumulator(position);
+                auto child = position;
+                auto result = child.process(annotation.move.from, annotation.move.to);
+                auto pv = std::vector<Game::Move>();
+                annotation.playedScore = searchChild(child, result, annotation.move, position.getCurrentPlayer(),
+                                                     accumulator ? &*accumulator : nullptr, depth,
+                                                     -g_winScore - 1, g_winScore + 1, 0, pv);
+            }
+            annotation.loss = std::max(0, annotation.bestScore - annotation.playedScore);
+        }
+    };
+
+    auto count = threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    count = std::min(count, static_cast<int>(positions.size()));
+    auto workers = std::vector<std::thread>();
+    for (auto i = 1; i < count; i++) workers.emplace_back(work);
+    work();
+    for (auto & worker : workers) worker.join();
+    return annotations;
+}
+
+int Engine::evaluate(Game const & game) const {
+    auto accumulator = createAccumulator(game);
+    return evaluate(game, accumulator ? &*accumulator : nullptr);
+}
+
+std::optional<nnue::Accumulator> Engine::createAccumulator(Game const & game) const {
+    if (m_network == nullptr || game.getSize() != Game::g_standardSize) return std::nullopt;
+    auto accumulator = nnue::Accumulator(*m_network);
+    accumulator.refresh(game);
+    return accumulator;
+}
+
+int Engine::evaluate(Game const & game, nnue::Accumulator const * accumulator) const {
+    if (accumulator != nullptr) return accumulator->evaluate(game.getCurrentPlayer());
+    auto score = 0;
+    auto size = game.getSize();
+    for (auto i = 0; i < size; i++) {
+        for (auto j = 0; j < size; j++) {
+            auto tile = game.get({i, j});
+            if (tile == Game::Tile::Blank) continue;
+            auto value = tile == Game::Tile::WhiteQueen || tile == Game::Tile::BlackQueen ? g_queenValue : g_pawnValue;
+            score += game.getPawnColor({i, j}) == game.getCurrentPlayer() ? value : -value;
+        }
+    }
+    return score;
+}
+
+int Engine::negamax(Game const & game, nnue::Accumulator const * accumulator,
+                    int depth, int alpha, int beta, int ply, std::vector<Game::Move> & pv) const {
+    pv.clear();
+    if (depth <= 0) return evaluate(game, accumulator);
+
+    // Player without any legal move loses, the sooner the worse
+    auto moves = game.getMoves();
+    if (moves.empty()) return -g_winScore + ply;
+
+    auto mover = game.getCurrentPlayer();
+    auto best = -g_winScore - 1;
+    auto childPv = std::vector<Game::Move>();
+    for (auto const & move : moves) {
+        auto child = game;
+        auto result = child.process(move.from, move.to);
+        auto score = searchChild(child, result, move, mover, accumulator, depth, alpha, beta, ply, childPv);
+        best = std::max(best, score);
+        if (score > alpha) {
+            alpha = score;
+            pv.assign(1, move);
+            pv.insert(pv.end(), childPv.begin(), childPv.end());
+        }
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+int Engine::searchChild(Game const & child, Game::MoveResult const & result, Game::Move const & move,
+                        Game::Player mover, nnue::Accumulator const * accumulator,
+                        int depth, int alpha, int beta, int ply, std::vector<Game::Move> & pv) const {
+    if (result.winner == mover) {
+        pv.clear();
+        return g_winScore - ply - 1;
+    }
+    if (accumulator == nullptr) return -negamax(child, nullptr, depth - 1, -beta, -alpha, ply + 1, pv);
+    auto next = *accumulator;
+    next.update(child, move.from, move.to, result);
+    return -negamax(child, &next, depth - 1, -beta, -alpha, ply + 1, pv);
+}
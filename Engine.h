@@ -0,0 +1,68 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_ENGINE_H
+#define UTP_GAME_PROJECT_LOGIC_ENGINE_H
+
+#include "Game.h"
+#include "Nnue.h"
+#include <optional>
+#include <vector>
+
+class OpeningBook;
+
+// Alpha-beta searcher of the bot. Evaluates positions with the network if one is given
+// and with the material balance otherwise. Known openings are answered from the book.
+class Engine {
+
+public:
+
+    static constexpr int g_winScore = 100000;
+
+    // Single analysed root move together with its principal variation, which starts with the move
+    struct Line {
+        Game::Move move;
+        int score;
+        std::vector<Game::Move> pv;
+    };
+
+    // Evaluation of a single played move
+    struct Annotation {
+        Game::Move move; // Move, which was played
+        Game::Move best; // Best move found in the position before it
+        int bestScore; // Score of the best move from the mover's point of view
+        int playedScore; // Score of the played move from the mover's point of view
+        int loss; // How much the played move lost compared to the best one, never negative
+        bool isCorrect; // Whether the played move was legal, annotation stops at the first illegal one
+    };
+
+    explicit Engine(nnue::Network const * network = nullptr, OpeningBook const * book = nullptr);
+
+    // Returns the move to play, the book move if there is one. Empty if there are no legal moves.
+    [[nodiscard]] std::optional<Game::Move> getBestMove(Game const & game, int depth) const;
+
+    // Returns the score of the position searched to the given depth from the player to move point of view.
+    [[nodiscard]] int search(Game const & game, int depth) const;
+
+    // Returns up to `lines` best root moves with their exact scores and principal variations, best first.
+    [[nodiscard]] std::vector<Line> analyse(Game const & game, int depth, int lines) const;
+
+    // Replays the moves from the start position and annotates every ply. Plies are searched
+    // in parallel on the given amount of threads, 0 uses all the hardware threads.
+    [[nodiscard]] std::vector<Annotation> annotate(Game const & start, std::vector<Game::Move> const & moves,
+                                                   int depth, int threads = 0) const;
+
+    // Returns the static score of the position from the player to move point of view.
+    [[nodiscard]] int evaluate(Game const & game) const;
+
+private:
+    [[nodiscard]] std::optional<nnue::Accumulator> createAccumulator(Game const & game) const;
+    [[nodiscard]] int evaluate(Game const & game, nnue::Accumulator const * accumulator) const;
+    [[nodiscard]] int negamax(Game const & game, nnue::Accumulator const * accumulator,
+                              int depth, int alpha, int beta, int ply, std::vector<Game::Move> & pv) const;
+    [[nodiscard]] int searchChild(Game const & child, Game::MoveResult const & result, Game::Move const & move,
+                                  Game::Player mover, nnue::Accumulator const * accumulator,
+                                  int depth, int alpha, int beta, int ply, std::vector<Game::Move> & pv) const;
+
+    nnue::Network const * m_network;
+    OpeningBook const * m_book;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_ENGINE_H
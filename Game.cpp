@@ -4,6 +4,8 @@
 
 #include <iostream>
 #include <math.h>
+#include <algorithm>
+#include <stdexcept>
 #include "Game.h"
 
 
@@ -124,6 +126,28 @@ int Game::getWhitePawnsAmount() const {
     return m_whiteAmount;
 }
 
+int Game::getSize() const {
+    return static_cast<int>(m_data.size());
+}
+
+std::vector<Game::Move> Game::getMoves() const {
+    auto moves = std::vector<Move>();
+    auto size = static_cast<int>(m_data.size());
+    for (auto i = 0; i < size; i++) {
+        for (auto j = 0; j < size; j++) {
+            if (getPawnColor({i, j}) != m_current) continue;
+            // Every kind of move keeps the pawn on diagonals, thus on the tiles of the same color
+            for (auto k = 0; k < size; k++) {
+                for (auto l = (i + j + k) % 2; l < size; l += 2) {
+                    if (!isFree({k, l})) continue;
+                    if (check({i, j}, {k, l}).isCorrect) moves.push_back(Move{{i, j}, {k, l}});
+                }
+            }
+        }
+    }
+    return moves;
+}
+
 
 ////////////////////////////////////////////////
 ////////////////////////////////////////////////
@@ -135,7 +159,7 @@ int Game::getWhitePawnsAmount() const {
 Game::Game() {
     // Init the board
     m_data = std::vector<std::unique_ptr<std::vector<Tile>>>();
-    auto size = 8;
+    auto size = g_standardSize;
     for (auto i = 0; i < size; i++) {
         auto row = std::make_unique<std::vector<Tile>>(10, Tile::Blank);
         m_data.push_back(std::move(row));
@@ -178,6 +202,21 @@ Game::Game(const std::vector<Game::Tile> &state, Player const& currentPlayer)
     }
 }
 
+Game::Game(Game const & other)
+: m_current(other.m_current), m_whiteAmount(other.m_whiteAmount), m_blackAmount(other.m_blackAmount) {
+    for (auto const & row : other.m_data) m_data.push_back(std::make_unique<std::vector<Tile>>(*row));
+}
+
+Game & Game::operator = (Game const & other) {
+    if (this == &other) return *this;
+    m_data.clear();
+    for (auto const & row : other.m_data) m_data.push_back(std::make_unique<std::vector<Tile>>(*row));
+    m_current = other.m_current;
+    m_whiteAmount = other.m_whiteAmount;
+    m_blackAmount = other.m_blackAmount;
+    return *this;
+}
+
 void Game::fill(Game::Tile pawn, std::vector<int> const & range) {
     for (auto i : range) {
         auto condition = (i + i / m_data.size()) % 2 == 1;
@@ -185,7 +224,7 @@ void Game::fill(Game::Tile pawn, std::vector<int> const & range) {
     }
 }
 
-Game::MoveResult Game::process(std::pair<int, int> const & from, std::pair<int, int> const & to) {
+Game::MoveResult Game::check(std::pair<int, int> const & from, std::pair<int, int> const & to) const {
     auto result = MoveResult();
     result.winner = Player::None;
     result.isCorrect = false;
@@ -222,6 +261,12 @@ Game::MoveResult Game::process(std::pair<int, int> const & from, std::pair<int,
         processPawn(result, from, to);
     }
 
+    return result;
+}
+
+Game::MoveResult Game::process(std::pair<int, int> const & from, std::pair<int, int> const & to) {
+    auto result = check(from, to);
+
     // Checks whether checking process succeeded
     if (!result.isCorrect) return result;
 
@@ -6,12 +6,17 @@
 #define UTP_GAME_PROJECT_LOGIC_GAME_H
 
 #include <vector>
+#include <memory>
+#include <string>
 
 // Contains whole game state management
 class Game {
 
 public:
 
+    // Size of the board set up by the default constructor
+    static constexpr int g_standardSize = 8;
+
     // Represents a single game tile
     enum class Tile {
         Blank, BlackPawn, WhitePawn, BlackQueen, WhiteQueen,
@@ -31,6 +36,12 @@ public:
         std::string message; // Description of an error if such occurred
     };
 
+    // Represents a single move of the pawn
+    struct Move {
+        std::pair<int, int> from;
+        std::pair<int, int> to;
+    };
+
     ////////////////////////////////////
     ////////////////////////////////////
 
@@ -49,12 +60,19 @@ public:
 
     [[nodiscard]] int getWhitePawnsAmount() const;
     [[nodiscard]] int getBlackPawnsAmount() const;
+    [[nodiscard]] int getSize() const;
+    [[nodiscard]] std::vector<Move> getMoves() const;
 
     ////////////////////////////////////
     ////////////////////////////////////
 
     Game();
     Game(std::vector<Game::Tile> const &state, Player const& currentPlayer);
+    Game(Game const & other);
+    Game(Game && other) = default;
+    Game & operator = (Game const & other);
+    Game & operator = (Game && other) = default;
+    [[nodiscard]] MoveResult check(std::pair<int, int> const & from, std::pair<int, int> const & to) const;
     MoveResult process(std::pair<int, int> const & from, std::pair<int, int> const & to);
     void processPawn(MoveResult & result, std::pair<int, int> const & from, std::pair<int, int> const & to) const;
     void processQueen(MoveResult & result, std::pair<int, int> const & from, std::pair<int, int> const & to) const;
@@ -0,0 +1,45 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+
+MappedFile::MappedFile(std::string const & path, std::string const & kind) : m_mapping(nullptr), m_size(0) {
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Could not open " + kind + " " + path + ": " + std::strerror(errno));
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        auto error = errno;
+        close(fd);
+        throw std::runtime_error("Could not read size of " + kind + " " + path + ": " + std::strerror(error));
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    // Empty file cannot be mapped, it is left without any data
+    if (m_size > 0) {
+        m_mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        close(fd);
+        if (m_mapping == MAP_FAILED) throw std::runtime_error("Could not map " + kind + " " + path + ": " + std::strerror(error));
+    }
+    else close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (m_mapping != nullptr) munmap(m_mapping, m_size);
+}
+
+char const * MappedFile::data() const {
+    return static_cast<char const *>(m_mapping);
+}
+
+std::size_t MappedFile::size() const {
+    return m_size;
+}
+
+bool MappedFile::hasHeader(char const * magic, std::size_t magicSize, std::size_t headerSize) const {
+    return m_size >= headerSize && m_size >= magicSize && std::memcmp(data(), magic, magicSize) == 0;
+}
@@ -0,0 +1,28 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_MAPPEDFILE_H
+#define UTP_GAME_PROJECT_LOGIC_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Whole file mapped read-only into the memory. Failures are reported by exceptions,
+// which name the file by its kind, e.g. "opening book".
+class MappedFile {
+
+public:
+    MappedFile(std::string const & path, std::string const & kind);
+    ~MappedFile();
+    MappedFile(MappedFile const &) = delete;
+    MappedFile & operator = (MappedFile const &) = delete;
+
+    [[nodiscard]] char const * data() const;
+    [[nodiscard]] std::size_t size() const;
+
+    // Returns whether the file is long enough for the header and starts with the magic.
+    [[nodiscard]] bool hasHeader(char const * magic, std::size_t magicSize, std::size_t headerSize) const;
+
+private:
+    void * m_mapping;
+    std::size_t m_size;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_MAPPEDFILE_H
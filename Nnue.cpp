@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <stdexcept>
+#include "Nnue.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nnue {
+
+    ///////////////////////////////////////////////////////
+    /// SIMD kernels
+    ///////////////////////////////////////////////////////
+
+
+    namespace {
+
+        void addRow(std::int16_t * values, std::int16_t const * row) {
+#if defined(__AVX2__)
+            for (auto i = 0; i < g_hiddenSize; i += 16) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+                auto w = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), _mm256_add_epi16(v, w));
+            }
+#elif defined(__SSE2__)
+            for (auto i = 0; i < g_hiddenSize; i += 8) {
+                auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+                auto w = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_add_epi16(v, w));
+            }
+#else
+            for (auto i = 0; i < g_hiddenSize; i++) values[i] = static_cast<std::int16_t>(values[i] + row[i]);
+#endif
+        }
+
+        void subtractRow(std::int16_t * values, std::int16_t const * row) {
+#if defined(__AVX2__)
+            for (auto i = 0; i < g_hiddenSize; i += 16) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+                auto w = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), _mm256_sub_epi16(v, w));
+            }
+#elif defined(__SSE2__)
+            for (auto i = 0; i < g_hiddenSize; i += 8) {
+                auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+                auto w = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_sub_epi16(v, w));
+            }
+#else
+            for (auto i = 0; i < g_hiddenSize; i++) values[i] = static_cast<std::int16_t>(values[i] - row[i]);
+#endif
+        }
+
+        // Clipped ReLU of the accumulator half multiplied by the matching output weights
+        std::int32_t propagate(std::int16_t const * values, std::int8_t const * weights) {
+#if defined(__AVX2__)
+            auto zero = _mm256_setzero_si256();
+            auto max = _mm256_set1_epi16(g_activationMax);
+            auto sum = _mm256_setzero_si256();
+            for (auto i = 0; i < g_hiddenSize; i += 16) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+                v = _mm256_max_epi16(_mm256_min_epi16(v, max), zero);
+                auto w = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(weights + i)));
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(v, w));
+            }
+            auto half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+            auto zero = _mm_setzero_si128();
+            auto max = _mm_set1_epi16(g_activationMax);
+            auto sum = _mm_setzero_si128();
+            for (auto i = 0; i < g_hiddenSize; i += 8) {
+                auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+                v = _mm_max_epi16(_mm_min_epi16(v, max), zero);
+                auto w = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(weights + i));
+                w = _mm_srai_epi16(_mm_unpacklo_epi8(w, w), 8); // sign extension of the int8 weights
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(v, w));
+            }
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(sum);
+#else
+            auto sum = std::int32_t{0};
+            for (auto i = 0; i < g_hiddenSize; i++)
+                sum += std::clamp<std::int32_t>(values[i], 0, g_activationMax) * weights[i];
+            return sum;
+#endif
+        }
+
+        // Perspective 0 sees the board as white, perspective 1 as black with the board rotated,
+        // so that both of them learn the same patterns for their own pawns.
+        int featureIndex(int perspective, Game::Tile tile, int square) {
+            auto isWhite = tile == Game::Tile::WhitePawn || tile == Game::Tile::WhiteQueen;
+            auto isQueen = tile == Game::Tile::WhiteQueen || tile == Game::Tile::BlackQueen;
+            auto isOwn = (perspective == 0) == isWhite;
+            auto kind = (isOwn ? 0 : 2) + (isQueen ? 1 : 0);
+            auto relative = perspective == 0 ? square : g_squares - 1 - square;
+            return kind * g_squares + relative;
+        }
+
+        int squareIndex(std::pair<int, int> const & position) {
+            return position.first * Game::g_standardSize + position.second;
+        }
+
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Network
+    ///////////////////////////////////////////////////////
+
+
+    Network::Network(std::string const & path) : m_file(path, "network weights file") {
+        auto expected = sizeof(FileHeader)
+                        + sizeof(std::int16_t) * g_hiddenSize
+                        + sizeof(std::int16_t) * g_inputSize * g_hiddenSize
+                        + sizeof(std::int8_t) * 2 * g_hiddenSize;
+        if (m_file.size() != expected)
+            throw std::runtime_error("Network weights file " + path + " has incorrect size.");
+
+        auto bytes = m_file.data();
+        m_header = reinterpret_cast<FileHeader const *>(bytes);
+        if (!m_file.hasHeader(g_magic, sizeof(g_magic), sizeof(FileHeader)) ||
+            m_header->inputSize != g_inputSize || m_header->hiddenSize != g_hiddenSize)
+            throw std::runtime_error("Network weights file " + path + " does not match the network architecture.");
+        if (m_header->outputShift < 0 || m_header->outputShift >= 32)
+            throw std::runtime_error("Network weights file " + path + " has incorrect output shift.");
+        m_biases = reinterpret_cast<std::int16_t const *>(bytes + sizeof(FileHeader));
+        m_weights = m_biases + g_hiddenSize;
+        m_outputs = reinterpret_cast<std::int8_t const *>(m_weights + g_inputSize * g_hiddenSize);
+    }
+
+    std::int16_t const * Network::getFeatureBiases() const {
+        return m_biases;
+    }
+
+    std::int16_t const * Network::getFeatureWeights(int feature) const {
+        return m_weights + feature * g_hiddenSize;
+    }
+
+    std::int8_t const * Network::getOutputWeights() const {
+        return m_outputs;
+    }
+
+    std::int32_t Network::getOutputBias() const {
+        return m_header->outputBias;
+    }
+
+    std::int32_t Network::getOutputShift() const {
+        return m_header->outputShift;
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Accumulator
+    ///////////////////////////////////////////////////////
+
+
+    Accumulator::Accumulator(Network const & network) : m_network(&network), m_values(), m_tiles() {
+        m_tiles.fill(Game::Tile::Blank);
+    }
+
+    void Accumulator::refresh(Game const & game) {
+        if (game.getSize() != Game::g_standardSize)
+            throw std::runtime_error("Network evaluation supports only the standard board size.");
+        for (auto & values : m_values)
+            std::copy_n(m_network->getFeatureBiases(), g_hiddenSize, values.begin());
+        m_tiles.fill(Game::Tile::Blank);
+        for (auto i = 0; i < Game::g_standardSize; i++) {
+            for (auto j = 0; j < Game::g_standardSize; j++) {
+                auto tile = game.get({i, j});
+                if (tile != Game::Tile::Blank) addTile(tile, squareIndex({i, j}));
+            }
+        }
+    }
+
+    void Accumulator::update(Game const & game, std::pair<int, int> const & from,
+                             std::pair<int, int> const & to, Game::MoveResult const & result) {
+        removeTile(m_tiles[squareIndex(from)], squareIndex(from));
+        for (auto const & p : result.takenPawns) removeTile(m_tiles[squareIndex(p)], squareIndex(p));
+        addTile(game.get(to), squareIndex(to));
+    }
+
+    int Accumulator::evaluate(Game::Player side) const {
+        auto us = side == Game::Player::Black ? 1 : 0;
+        auto outputs = m_network->getOutputWeights();
+        auto sum = propagate(m_values[us].data(), outputs)
+                   + propagate(m_values[1 - us].data(), outputs + g_hiddenSize)
+                   + m_network->getOutputBias();
+        return sum >> m_network->getOutputShift();
+    }
+
+    void Accumulator::addTile(Game::Tile tile, int square) {
+        m_tiles[square] = tile;
+        for (auto perspective = 0; perspective < 2; perspective++)
+            addRow(m_values[perspective].data(),
+                   m_network->getFeatureWeights(featureIndex(perspective, tile, square)));
+    }
+
+    void Accumulator::removeTile(Game::Tile tile, int square) {
+        m_tiles[square] = Game::Tile::Blank;
+        for (auto perspective = 0; perspective < 2; perspective++)
+            subtractRow(m_values[perspective].data(),
+                        m_network->getFeatureWeights(featureIndex(perspective, tile, square)));
+    }
+
+}
@@ -0,0 +1,94 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_NNUE_H
+#define UTP_GAME_PROJECT_LOGIC_NNUE_H
+
+#include "Game.h"
+#include "MappedFile.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Small quantized neural network evaluation, whose first layer is kept
+// up to date incrementally as the moves are processed.
+namespace nnue {
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    constexpr int g_squares = Game::g_standardSize * Game::g_standardSize;
+    constexpr int g_pieceKinds = 4; // own pawn, own queen, opponent pawn, opponent queen
+    constexpr int g_inputSize = g_pieceKinds * g_squares;
+    constexpr int g_hiddenSize = 128;
+    constexpr int g_activationMax = 127;
+    constexpr char g_magic[8] = {'U', 'T', 'P', 'N', 'N', 'U', 'E', '1'};
+
+    // Layout of the weights file header. It is followed by int16 feature biases [hidden],
+    // int16 feature weights [input][hidden] and int8 output weights [2 * hidden], where the first
+    // half of the output weights is applied to the side to move and the second to its opponent.
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t inputSize;
+        std::uint32_t hiddenSize;
+        std::int32_t outputBias;
+        std::int32_t outputShift;
+        std::uint8_t reserved[40];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Weights header has to keep the arrays behind it aligned.");
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Read-only quantized weights mapped straight from the file, so that
+    // many evaluators share the same physical pages.
+    class Network {
+
+    public:
+        explicit Network(std::string const & path);
+
+        [[nodiscard]] std::int16_t const * getFeatureBiases() const;
+        [[nodiscard]] std::int16_t const * getFeatureWeights(int feature) const;
+        [[nodiscard]] std::int8_t const * getOutputWeights() const;
+        [[nodiscard]] std::int32_t getOutputBias() const;
+        [[nodiscard]] std::int32_t getOutputShift() const;
+
+    private:
+        MappedFile m_file;
+        FileHeader const * m_header;
+        std::int16_t const * m_biases;
+        std::int16_t const * m_weights;
+        std::int8_t const * m_outputs;
+    };
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // First layer outputs for both perspectives. After the initial refresh it is only
+    // patched with the tiles, which were touched by the processed move.
+    class Accumulator {
+
+    public:
+        explicit Accumulator(Network const & network);
+
+        // Recomputes the accumulator from scratch for the given board.
+        void refresh(Game const & game);
+
+        // Applies the result of the successful `game.process(from, to)`. Must be called
+        // after processing, since the tile landing on `to` already includes the promotion.
+        void update(Game const & game, std::pair<int, int> const & from,
+                    std::pair<int, int> const & to, Game::MoveResult const & result);
+
+        // Returns the score from the given player's point of view.
+        [[nodiscard]] int evaluate(Game::Player side) const;
+
+    private:
+        void addTile(Game::Tile tile, int square);
+        void removeTile(Game::Tile tile, int square);
+
+        Network const * m_network;
+        alignas(32) std::array<std::array<std::int16_t, g_hiddenSize>, 2> m_values;
+        std::array<Game::Tile, g_squares> m_tiles;
+    };
+
+}
+
+#endif //UTP_GAME_PROJECT_LOGIC_NNUE_H
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "Engine.h"
+#include "OpeningBook.h"
+#include "Zobrist.h"
+
+namespace {
+
+    constexpr char g_magic[8] = {'U', 'T', 'P', 'B', 'O', 'O', 'K', '1'};
+    constexpr int g_interpolationSteps = 8;
+    constexpr std::size_t g_binaryThreshold = 64;
+
+    bool isBefore(BookEntry const & left, BookEntry const & right) {
+        return std::tie(left.hash, left.fromRow, left.fromCol, left.toRow, left.toCol) <
+               std::tie(right.hash, right.fromRow, right.fromCol, right.toRow, right.toCol);
+    }
+
+    Game::Move toMove(BookEntry const & entry) {
+        return Game::Move{{entry.fromRow, entry.fromCol}, {entry.toRow, entry.toCol}};
+    }
+
+}
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Opening Book
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+OpeningBook::OpeningBook(std::string const & path) : m_file(path, "opening book") {
+    if (!m_file.hasHeader(g_magic, sizeof(g_magic), sizeof(FileHeader)))
+        throw std::runtime_error("Opening book " + path + " does not match the book format.");
+    auto header = reinterpret_cast<FileHeader const *>(m_file.data());
+    if (header->entrySize != sizeof(BookEntry) ||
+        m_file.size() != sizeof(FileHeader) + std::size_t{header->entries} * sizeof(BookEntry))
+        throw std::runtime_error("Opening book " + path + " does not match the book format.");
+    m_entries = {reinterpret_cast<BookEntry const *>(m_file.data() + sizeof(FileHeader)), header->entries};
+}
+
+std::span<BookEntry const> OpeningBook::probe(std::uint64_t hash) const {
+    auto low = std::size_t{0};
+    auto high = m_entries.size();
+
+    // Interpolation quickly narrows the range over the uniform hashes, the binary search finishes it
+    for (auto step = 0; step < g_interpolationSteps && high - low > g_binaryThreshold; step++) {
+        auto lowHash = m_entries[low].hash;
+        auto highHash = m_entries[high - 1].hash;
+        if (hash < lowHash || hash > highHash) return {};
+        if (lowHash == highHash) break;
+        auto fraction = static_cast<long double>(hash - lowHash) / static_cast<long double>(highHash - lowHash);
+        auto middle = low + static_cast<std::size_t>(fraction * static_cast<long double>(high - 1 - low));
+        if (m_entries[middle].hash < hash) low = middle + 1;
+        else if (m_entries[middle].hash > hash) high = middle;
+        else break;
+    }
+
+    auto range = m_entries.subspan(low, high - low);
+    auto [first, last] = std::ranges::equal_range(range, hash, std::ranges::less(), &BookEntry::hash);
+    return {first, last};
+}
+
+std::optional<Game::Move> OpeningBook::getMove(Game const & game) const {
+    if (game.getSize() != Game::g_standardSize) return std::nullopt;
+    auto best = std::optional<Game::Move>();
+    auto bestWeight = -1;
+    for (auto const & entry : probe(zobrist::hash(game))) {
+        // Hash collisions and foreign books may point to moves, which are illegal or off the board
+        auto move = toMove(entry);
+        if (entry.weight <= bestWeight || !game.hasPosition(move.from) || !game.hasPosition(move.to) ||
+            !game.check(move.from, move.to).isCorrect) continue;
+        best = move;
+        bestWeight = entry.weight;
+    }
+    return best;
+}
+
+void OpeningBook::write(std::string const & path, std::vector<BookEntry> entries) {
+    std::ranges::sort(entries, isBefore);
+    auto header = FileHeader();
+    std::memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.entrySize = sizeof(BookEntry);
+    header.entries = static_cast<std::uint32_t>(entries.size());
+
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const *>(entries.data()),
+               static_cast<std::streamsize>(entries.size() * sizeof(BookEntry)));
+    if (!file) throw std::runtime_error("Could not write opening book " + path + ".");
+}
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Opening Book Builder
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+bool OpeningBookBuilder::addGame(std::vector<Game::Move> const & moves, int plies) {
+    auto game = Game();
+    for (auto i = 0; i < moves.size() && i < plies; i++) {
+        if (!game.hasPosition(moves[i].from) || !game.hasPosition(moves[i].to)) return false;
+        auto hash = zobrist::hash(game);
+        auto result = game.process(moves[i].from, moves[i].to);
+        if (!result.isCorrect) return false;
+        m_weights[{hash, moves[i].from, moves[i].to}]++;
+        if (result.winner != Game::Player::None) break;
+    }
+    return true;
+}
+
+void OpeningBookBuilder::addAnalysis(Engine const & engine, int plies, int depth, std::uint16_t weight) {
+    auto visited = std::set<std::uint64_t>();
+    analyse(engine, Game(), plies, depth, weight, visited);
+}
+
+void OpeningBookBuilder::analyse(Engine const & engine, Game const & game, int plies, int depth,
+                                 std::uint16_t weight, std::set<std::uint64_t> & visited) {
+    if (plies <= 0) return;
+    auto hash = zobrist::hash(game);
+    if (!visited.insert(hash).second) return;
+
+    auto best = engine.getBestMove(game, depth);
+    if (!best) return;
+    m_weights[{hash, best->from, best->to}] += weight;
+
+    // Continues through every move known for this position, the engine choice included
+    auto moves = std::vector<Game::Move>();
+    auto first = m_weights.lower_bound({hash, {0, 0}, {0, 0}});
+    for (auto it = first; it != m_weights.end() && std::get<0>(it->first) == hash; ++it)
+        moves.push_back(Game::Move{std::get<1>(it->first), std::get<2>(it->first)});
+    for (auto const & move : moves) {
+        auto child = game;
+        if (child.process(move.from, move.to).winner != Game::Player::None) continue;
+        analyse(engine, child, plies - 1, depth, weight, visited);
+    }
+}
+
+std::vector<BookEntry> OpeningBookBuilder::getEntries() const {
+    auto entries = std::vector<BookEntry>();
+    for (auto const & [key, weight] : m_weights) {
+        auto const & [hash, from, to] = key;
+        entries.push_back(BookEntry{
+            hash,
+            static_cast<std::uint8_t>(from.first), static_cast<std::uint8_t>(from.second),
+            static_cast<std::uint8_t>(to.first), static_cast<std::uint8_t>(to.second),
+            static_cast<std::uint16_t>(std::min<std::uint32_t>(weight, UINT16_MAX)),
+            0
+        });
+    }
+    return entries;
+}
@@ -0,0 +1,86 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_OPENINGBOOK_H
+#define UTP_GAME_PROJECT_LOGIC_OPENINGBOOK_H
+
+#include "Game.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Engine;
+
+// Single book move. Entries are sorted by the position hash, then by the move.
+struct BookEntry {
+    std::uint64_t hash; // Zobrist hash of the position before the move
+    std::uint8_t fromRow;
+    std::uint8_t fromCol;
+    std::uint8_t toRow;
+    std::uint8_t toCol;
+    std::uint16_t weight; // Relative preference among the moves of the same position
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(BookEntry) == 16, "Book entries are stored on disk as they are laid out in memory.");
+
+// Read-only opening book mapped straight from the file. Since the hashes are
+// uniformly distributed, the positions are located with the interpolation search.
+class OpeningBook {
+
+public:
+
+    // Layout of the book file header, it is followed by `entries` sorted book entries.
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t entrySize;
+        std::uint32_t entries;
+        std::uint8_t reserved[48];
+    };
+
+    explicit OpeningBook(std::string const & path);
+
+    // Returns all the book moves of the position with the given hash.
+    [[nodiscard]] std::span<BookEntry const> probe(std::uint64_t hash) const;
+
+    // Returns the legal book move with the highest weight for the position.
+    [[nodiscard]] std::optional<Game::Move> getMove(Game const & game) const;
+
+    // Sorts the entries and writes them as the book file.
+    static void write(std::string const & path, std::vector<BookEntry> entries);
+
+private:
+    MappedFile m_file;
+    std::span<BookEntry const> m_entries;
+};
+
+static_assert(sizeof(OpeningBook::FileHeader) == 64, "Book header has to keep the entries aligned.");
+
+// Collects the book moves offline from the recorded games and from the engine analysis.
+class OpeningBookBuilder {
+
+public:
+
+    // Adds the moves of the game played from the initial setup, up to the given ply.
+    // Returns false if the game contains an illegal move, in which case the moves before it are kept.
+    bool addGame(std::vector<Game::Move> const & moves, int plies);
+
+    // Walks the book tree from the initial setup up to the given ply and adds the engine
+    // choice at the given depth to every visited position.
+    void addAnalysis(Engine const & engine, int plies, int depth, std::uint16_t weight);
+
+    [[nodiscard]] std::vector<BookEntry> getEntries() const;
+
+private:
+    void analyse(Engine const & engine, Game const & game, int plies, int depth, std::uint16_t weight,
+                 std::set<std::uint64_t> & visited);
+
+    // Weight of the (hash, from, to) move
+    std::map<std::tuple<std::uint64_t, std::pair<int, int>, std::pair<int, int>>, std::uint32_t> m_weights;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_OPENINGBOOK_H
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "Poller.h"
+
+#ifdef __linux__
+
+Poller::Poller() : m_fd(epoll_create1(EPOLL_CLOEXEC)), m_ready(256) {
+    if (m_fd < 0) throw std::runtime_error(std::string("Could not create epoll instance: ") + std::strerror(errno));
+}
+
+Poller::~Poller() {
+    close(m_fd);
+}
+
+void Poller::add(int fd) {
+    auto event = epoll_event();
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+        throw std::runtime_error(std::string("Could not register descriptor: ") + std::strerror(errno));
+}
+
+void Poller::remove(int fd) {
+    epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void Poller::setInterest(int fd, bool readable, bool writable) {
+    auto event = epoll_event();
+    event.events = (readable ? static_cast<std::uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u)
+                   | (writable ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = fd;
+    epoll_ctl(m_fd, EPOLL_CTL_MOD, fd, &event);
+}
+
+std::vector<Poller::Event> const & Poller::wait(int timeout) {
+    m_events.clear();
+    auto count = epoll_wait(m_fd, m_ready.data(), static_cast<int>(m_ready.size()), timeout);
+    for (auto i = 0; i < count; i++) {
+        auto flags = m_ready[i].events;
+        m_events.push_back(Event{
+            m_ready[i].data.fd,
+            (flags & EPOLLIN) != 0,
+            (flags & EPOLLOUT) != 0,
+            (flags & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) != 0
+        });
+    }
+    return m_events;
+}
+
+#else
+
+Poller::Poller() = default;
+
+Poller::~Poller() = default;
+
+void Poller::add(int fd) {
+    m_fds.push_back(pollfd{fd, POLLIN, 0});
+}
+
+void Poller::remove(int fd) {
+    std::erase_if(m_fds, [fd](auto const & p){ return p.fd == fd; });
+}
+
+void Poller::setInterest(int fd, bool readable, bool writable) {
+    auto it = std::ranges::find(m_fds, fd, &pollfd::fd);
+    if (it != m_fds.end()) it->events = static_cast<short>((readable ? POLLIN : 0) | (writable ? POLLOUT : 0));
+}
+
+std::vector<Poller::Event> const & Poller::wait(int timeout) {
+    m_events.clear();
+    if (poll(m_fds.data(), static_cast<nfds_t>(m_fds.size()), timeout) <= 0) return m_events;
+    for (auto const & p : m_fds) {
+        if (p.revents == 0) continue;
+        m_events.push_back(Event{
+            p.fd,
+            (p.revents & POLLIN) != 0,
+            (p.revents & POLLOUT) != 0,
+            (p.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0
+        });
+    }
+    return m_events;
+}
+
+#endif
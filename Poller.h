@@ -0,0 +1,49 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_POLLER_H
+#define UTP_GAME_PROJECT_LOGIC_POLLER_H
+
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+// Level triggered readiness notifications. Uses epoll on Linux
+// and falls back to poll on the other POSIX systems.
+class Poller {
+
+public:
+
+    // Readiness of a single registered descriptor
+    struct Event {
+        int fd;
+        bool readable;
+        bool writable;
+        bool hangup;
+    };
+
+    Poller();
+    ~Poller();
+    Poller(Poller const &) = delete;
+    Poller & operator = (Poller const &) = delete;
+
+    void add(int fd);
+    void remove(int fd);
+    // Selects the notifications of the descriptor, hangups and errors are reported always.
+    void setInterest(int fd, bool readable, bool writable);
+
+    // Blocks until some descriptor is ready or the timeout in milliseconds passes (-1 waits forever).
+    [[nodiscard]] std::vector<Event> const & wait(int timeout);
+
+private:
+#ifdef __linux__
+    int m_fd;
+    std::vector<epoll_event> m_ready;
+#else
+    std::vector<pollfd> m_fds;
+#endif
+    std::vector<Event> m_events;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_POLLER_H
@@ -0,0 +1,135 @@
+#include <stdexcept>
+#include "Protocol.h"
+
+namespace protocol {
+
+    ///////////////////////////////////////////////////////
+    /// Writer
+    ///////////////////////////////////////////////////////
+
+
+    Writer::Writer() : m_buffer(g_headerSize, 0) {}
+
+    Writer & Writer::u8(std::uint8_t value) {
+        m_buffer.push_back(value);
+        return *this;
+    }
+
+    Writer & Writer::u16(std::uint16_t value) {
+        m_buffer.push_back(static_cast<std::uint8_t>(value));
+        m_buffer.push_back(static_cast<std::uint8_t>(value >> 8));
+        return *this;
+    }
+
+    Writer & Writer::u32(std::uint32_t value) {
+        for (auto i = 0; i < 4; i++) m_buffer.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        return *this;
+    }
+
+    Writer & Writer::bytes(std::string const & value) {
+        m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+        return *this;
+    }
+
+    std::vector<std::uint8_t> const & Writer::finish() {
+        auto size = static_cast<std::uint32_t>(m_buffer.size() - g_headerSize);
+        for (auto i = 0; i < 4; i++) m_buffer[i] = static_cast<std::uint8_t>(size >> (8 * i));
+        return m_buffer;
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Reader
+    ///////////////////////////////////////////////////////
+
+
+    Reader::Reader(std::uint8_t const * data, std::size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+    std::uint8_t Reader::u8() {
+        require(1);
+        return m_data[m_offset++];
+    }
+
+    std::uint16_t Reader::u16() {
+        require(2);
+        auto value = static_cast<std::uint16_t>(m_data[m_offset] | m_data[m_offset + 1] << 8);
+        m_offset += 2;
+        return value;
+    }
+
+    std::uint32_t Reader::u32() {
+        require(4);
+        auto value = std::uint32_t{0};
+        for (auto i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(m_data[m_offset + i]) << (8 * i);
+        m_offset += 4;
+        return value;
+    }
+
+    std::string Reader::bytes(std::size_t size) {
+        require(size);
+        auto value = std::string(reinterpret_cast<char const *>(m_data + m_offset), size);
+        m_offset += size;
+        return value;
+    }
+
+    bool Reader::atEnd() const {
+        return m_offset == m_size;
+    }
+
+    void Reader::require(std::size_t size) const {
+        if (m_size - m_offset < size) throw std::runtime_error("Protocol frame is shorter than its fields.");
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Shared encodings
+    ///////////////////////////////////////////////////////
+
+
+    std::optional<std::uint32_t> peekFrame(std::uint8_t const * data, std::size_t size) {
+        if (size < g_headerSize) return std::nullopt;
+        auto payload = Reader(data, g_headerSize).u32();
+        if (payload > g_maxPayloadSize) throw std::runtime_error("Protocol frame exceeds the maximal size.");
+        if (size - g_headerSize < payload) return std::nullopt;
+        return payload;
+    }
+
+    Game::Tile readTile(Reader & reader) {
+        auto value = reader.u8();
+        if (value > static_cast<std::uint8_t>(Game::Tile::WhiteQueen))
+            throw std::runtime_error("Protocol frame contains an unknown tile.");
+        return static_cast<Game::Tile>(value);
+    }
+
+    Game::Player readPlayer(Reader & reader) {
+        auto value = reader.u8();
+        if (value > static_cast<std::uint8_t>(Game::Player::None))
+            throw std::runtime_error("Protocol frame contains an unknown player.");
+        return static_cast<Game::Player>(value);
+    }
+
+    void writeResult(Writer & writer, Game::MoveResult const & result) {
+        writer.u8(result.isCorrect ? 1 : 0)
+              .u8(result.isQueen ? 1 : 0)
+              .u8(static_cast<std::uint8_t>(result.winner))
+              .u8(static_cast<std::uint8_t>(result.takenPawns.size()));
+        for (auto const & p : result.takenPawns)
+            writer.u8(static_cast<std::uint8_t>(p.first)).u8(static_cast<std::uint8_t>(p.second));
+        writer.u16(static_cast<std::uint16_t>(result.message.size())).bytes(result.message);
+    }
+
+    Game::MoveResult readResult(Reader & reader) {
+        auto result = Game::MoveResult();
+        result.isCorrect = reader.u8() != 0;
+        result.isQueen = reader.u8() != 0;
+        result.winner = readPlayer(reader);
+        auto taken = reader.u8();
+        for (auto i = 0; i < taken; i++) {
+            auto row = reader.u8();
+            result.takenPawns.emplace_back(row, reader.u8());
+        }
+        result.message = reader.bytes(reader.u16());
+        return result;
+    }
+
+}
@@ -0,0 +1,95 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_PROTOCOL_H
+#define UTP_GAME_PROJECT_LOGIC_PROTOCOL_H
+
+#include "Game.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Binary protocol spoken by the native game server. Every frame is a little-endian
+// u32 payload length followed by the payload. Requests start with the opcode, responses
+// echo the opcode followed by the status, after which the opcode specific fields follow:
+//
+//   Create  -> u8 size, [u8 player, size * size u8 tiles]    <- u32 session
+//   Process -> u32 session, u8 fromRow, fromCol, toRow, toCol <- encoded MoveResult
+//   Get     -> u32 session, u8 row, u8 col                   <- u8 tile
+//   State   -> u32 session                                   <- u8 player, white, black, size,
+//                                                               u16 plies, u32 whiteClock, blackClock
+//   Close   -> u32 session                                   <-
+//
+// Size 0 in Create stands for the default initial setup, otherwise only the standard
+// board size is accepted. Clocks hold milliseconds spent by each player on its moves.
+namespace protocol {
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    enum class Opcode : std::uint8_t {
+        Create = 1, Process, Get, State, Close,
+    };
+
+    enum class Status : std::uint8_t {
+        Ok, Malformed, UnknownOpcode, UnknownSession, Failed,
+    };
+
+    constexpr std::size_t g_headerSize = 4;
+    constexpr std::uint32_t g_maxPayloadSize = 64 * 1024;
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Builds a single frame, its length is filled in by `finish`.
+    class Writer {
+
+    public:
+        Writer();
+
+        Writer & u8(std::uint8_t value);
+        Writer & u16(std::uint16_t value);
+        Writer & u32(std::uint32_t value);
+        Writer & bytes(std::string const & value);
+
+        [[nodiscard]] std::vector<std::uint8_t> const & finish();
+
+    private:
+        std::vector<std::uint8_t> m_buffer;
+    };
+
+    // Bounds checked view over a single frame payload. Throws when the payload is too short.
+    class Reader {
+
+    public:
+        Reader(std::uint8_t const * data, std::size_t size);
+
+        std::uint8_t u8();
+        std::uint16_t u16();
+        std::uint32_t u32();
+        std::string bytes(std::size_t size);
+
+        [[nodiscard]] bool atEnd() const;
+
+    private:
+        void require(std::size_t size) const;
+
+        std::uint8_t const * m_data;
+        std::size_t m_size;
+        std::size_t m_offset;
+    };
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Returns the payload size of the frame at the start of the buffer if it is complete.
+    // Throws if the announced payload exceeds the allowed size.
+    std::optional<std::uint32_t> peekFrame(std::uint8_t const * data, std::size_t size);
+
+    Game::Tile readTile(Reader & reader);
+    Game::Player readPlayer(Reader & reader);
+    void writeResult(Writer & writer, Game::MoveResult const & result);
+    Game::MoveResult readResult(Reader & reader);
+
+}
+
+#endif //UTP_GAME_PROJECT_LOGIC_PROTOCOL_H
@@ -0,0 +1,85 @@
+#include "RuleEngine.h"
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Reference
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+ReferenceRuleEngine::ReferenceRuleEngine() = default;
+
+std::string ReferenceRuleEngine::getName() const {
+    return "reference";
+}
+
+void ReferenceRuleEngine::load(std::vector<Game::Tile> const & state, Game::Player player) {
+    m_game = Game(state, player);
+}
+
+Game::MoveResult ReferenceRuleEngine::process(std::pair<int, int> const & from, std::pair<int, int> const & to) {
+    return m_game.process(from, to);
+}
+
+Game ReferenceRuleEngine::getGame() const {
+    return m_game;
+}
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Copying
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+CopyingRuleEngine::CopyingRuleEngine() = default;
+
+std::string CopyingRuleEngine::getName() const {
+    return "copying";
+}
+
+void CopyingRuleEngine::load(std::vector<Game::Tile> const & state, Game::Player player) {
+    m_game = Game(state, player);
+}
+
+Game::MoveResult CopyingRuleEngine::process(std::pair<int, int> const & from, std::pair<int, int> const & to) {
+    auto child = m_game;
+    auto result = child.process(from, to);
+    m_game = std::move(child);
+    return result;
+}
+
+Game CopyingRuleEngine::getGame() const {
+    return m_game;
+}
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Packed
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+PackedRuleEngine::PackedRuleEngine() : m_record() {}
+
+std::string PackedRuleEngine::getName() const {
+    return "packed";
+}
+
+void PackedRuleEngine::load(std::vector<Game::Tile> const & state, Game::Player player) {
+    m_record = packSession(Game(state, player));
+}
+
+Game::MoveResult PackedRuleEngine::process(std::pair<int, int> const & from, std::pair<int, int> const & to) {
+    auto game = unpackSession(m_record);
+    auto result = game.process(from, to);
+    if (result.isCorrect) m_record = packSession(game);
+    return result;
+}
+
+Game PackedRuleEngine::getGame() const {
+    return unpackSession(m_record);
+}
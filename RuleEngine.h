@@ -0,0 +1,71 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_RULEENGINE_H
+#define UTP_GAME_PROJECT_LOGIC_RULEENGINE_H
+
+#include "Game.h"
+#include "SessionRecord.h"
+#include <string>
+#include <vector>
+
+// Implementation of the game rules under the differential test. Every implementation
+// has to match `Game::process` exactly, including the messages and the order of taken pawns.
+class RuleEngine {
+
+public:
+    virtual ~RuleEngine() = default;
+
+    [[nodiscard]] virtual std::string getName() const = 0;
+
+    // Sets up the position given as the flat board of the standard size.
+    virtual void load(std::vector<Game::Tile> const & state, Game::Player player) = 0;
+    virtual Game::MoveResult process(std::pair<int, int> const & from, std::pair<int, int> const & to) = 0;
+
+    // Returns the state after the processing in the reference form.
+    [[nodiscard]] virtual Game getGame() const = 0;
+};
+
+// The reference implementation itself
+class ReferenceRuleEngine : public RuleEngine {
+
+public:
+    ReferenceRuleEngine();
+
+    [[nodiscard]] std::string getName() const override;
+    void load(std::vector<Game::Tile> const & state, Game::Player player) override;
+    Game::MoveResult process(std::pair<int, int> const & from, std::pair<int, int> const & to) override;
+    [[nodiscard]] Game getGame() const override;
+
+private:
+    Game m_game;
+};
+
+// Game copied before every move, as the engine search does
+class CopyingRuleEngine : public RuleEngine {
+
+public:
+    CopyingRuleEngine();
+
+    [[nodiscard]] std::string getName() const override;
+    void load(std::vector<Game::Tile> const & state, Game::Player player) override;
+    Game::MoveResult process(std::pair<int, int> const & from, std::pair<int, int> const & to) override;
+    [[nodiscard]] Game getGame() const override;
+
+private:
+    Game m_game;
+};
+
+// Game kept as the packed session record and expanded for every move, as the server does
+class PackedRuleEngine : public RuleEngine {
+
+public:
+    PackedRuleEngine();
+
+    [[nodiscard]] std::string getName() const override;
+    void load(std::vector<Game::Tile> const & state, Game::Player player) override;
+    Game::MoveResult process(std::pair<int, int> const & from, std::pair<int, int> const & to) override;
+    [[nodiscard]] Game getGame() const override;
+
+private:
+    SessionRecord m_record;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_RULEENGINE_H
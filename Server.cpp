@@ -0,0 +1,551 @@
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Game.h"
+#include "Poller.h"
+#include "Protocol.h"
+#include "Server.h"
+#include "SessionSlab.h"
+#include "Socket.h"
+#include "Zobrist.h"
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Helper Functions
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+namespace {
+
+    // Lower bits of the session identifier name the worker owning it, the middle ones the slot
+    // and the upper ones the generation of the slot, so that the identifier of a closed session
+    // does not reach the next session in the same slot.
+    constexpr int g_workerBits = 8;
+    constexpr int g_generationBits = 6;
+    constexpr int g_slotBits = 32 - g_workerBits - g_generationBits;
+    constexpr std::uint32_t g_workerMask = (1u << g_workerBits) - 1;
+    constexpr std::uint32_t g_slotMask = (1u << g_slotBits) - 1;
+    constexpr std::uint32_t g_generationMask = (1u << g_generationBits) - 1;
+    constexpr std::uint32_t g_maxSlots = g_slotMask;
+
+    // Connection is not read until the client takes the responses above this size
+    constexpr std::size_t g_maxPendingOutput = 1024 * 1024;
+
+    // Client connection, which is handed between the workers together with its buffers.
+    struct Connection {
+        int fd;
+        std::vector<std::uint8_t> input;
+        std::vector<std::uint8_t> output;
+        std::size_t written;
+        bool wantsRead;
+        bool wantsWrite;
+    };
+
+    void makeWakePipe(int fds[2]) {
+        if (pipe(fds) != 0) throw std::runtime_error(std::string("Could not create pipe: ") + std::strerror(errno));
+        for (auto i = 0; i < 2; i++) {
+            net::setNonBlocking(fds[i]);
+            fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+        }
+    }
+
+    void drainPipe(int fd) {
+        char buffer[64];
+        while (read(fd, buffer, sizeof(buffer)) > 0) {}
+    }
+
+    void pinToCore(std::thread & thread, int core) {
+#ifdef __linux__
+        auto set = cpu_set_t();
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        // Thread affinity is only a hint on the other systems, the scheduler keeps the placement.
+        (void) thread;
+        (void) core;
+#endif
+    }
+
+    std::uint64_t getWallClock() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    // Slot is shifted by one, so that no session is identified by 0
+    std::uint32_t makeSessionId(std::uint32_t slot, std::uint8_t generation, int worker) {
+        return (generation & g_generationMask) << (g_workerBits + g_slotBits)
+               | (slot + 1) << g_workerBits
+               | static_cast<std::uint32_t>(worker);
+    }
+
+    // Returns the slot shifted by one, 0 for no slot.
+    std::uint32_t getSessionSlot(std::uint32_t session) {
+        return (session >> g_workerBits) & g_slotMask;
+    }
+
+    protocol::Writer reply(std::uint8_t opcode, protocol::Status status) {
+        auto writer = protocol::Writer();
+        writer.u8(opcode).u8(static_cast<std::uint8_t>(status));
+        return writer;
+    }
+
+}
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Worker
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+class Server::Worker {
+
+public:
+    Worker(int index, std::vector<std::unique_ptr<Worker>> const & workers, ServerConfig const & config)
+    : m_index(index), m_workers(workers), m_stopping(false), m_dirty(false),
+      m_checkpointInterval(std::chrono::seconds(config.checkpointInterval)) {
+        if (!config.checkpointDirectory.empty()) {
+            m_checkpointPath = config.checkpointDirectory + "/worker-" + std::to_string(index) + ".slab";
+            if (m_sessions.restore(m_checkpointPath)) {
+                // Time while the server was down is not counted against the players to move
+                auto now = getWallClock();
+                for (auto slot = 0u; slot < m_sessions.slots(); slot++) {
+                    auto record = m_sessions.find(slot);
+                    if (record != nullptr) record->lastMove = now;
+                }
+                std::cout << "Worker " << index << " restored " << m_sessions.size() << " sessions." << std::endl;
+            }
+        }
+        m_nextCheckpoint = std::chrono::steady_clock::now() + m_checkpointInterval;
+        makeWakePipe(m_wake);
+        m_poller.add(m_wake[0]);
+    }
+
+    ~Worker() {
+        for (auto & [fd, connection] : m_connections) close(fd);
+        for (auto & connection : m_incoming) close(connection->fd);
+        close(m_wake[0]);
+        close(m_wake[1]);
+    }
+
+    void start(int core) {
+        m_thread = std::thread([this]{ loop(); });
+        pinToCore(m_thread, core);
+    }
+
+    void stop() {
+        m_stopping = true;
+        wake();
+    }
+
+    void join() {
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    // Takes over the connection from the acceptor or from another worker.
+    void adopt(std::unique_ptr<Connection> connection) {
+        {
+            auto lock = std::lock_guard(m_mutex);
+            m_incoming.push_back(std::move(connection));
+        }
+        wake();
+    }
+
+private:
+
+    void wake() {
+        auto byte = char{1};
+        (void) write(m_wake[1], &byte, 1);
+    }
+
+    void loop() {
+        while (!m_stopping) {
+            for (auto const & event : m_poller.wait(getTimeout())) {
+                if (event.fd == m_wake[0]) {
+                    drainPipe(m_wake[0]);
+                    attachIncoming();
+                    continue;
+                }
+                auto it = m_connections.find(event.fd);
+                if (it == m_connections.end()) continue; // closed or migrated earlier in this batch
+                auto & connection = *it->second;
+                if (event.readable || event.hangup) {
+                    if (!receive(connection)) continue;
+                }
+                if (event.writable) processFrames(connection); // answers the frames held back by the full output
+            }
+            if (!m_checkpointPath.empty() && std::chrono::steady_clock::now() >= m_nextCheckpoint) checkpoint();
+        }
+        if (!m_checkpointPath.empty()) {
+            // Final checkpoint is written only after the running one, so that it is not skipped
+            if (m_checkpoint.valid()) finishCheckpoint();
+            checkpoint();
+            if (m_checkpoint.valid()) finishCheckpoint();
+        }
+    }
+
+    // Milliseconds until the next checkpoint is due, or infinite wait without checkpoints.
+    [[nodiscard]] int getTimeout() const {
+        if (m_checkpointPath.empty()) return -1;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                m_nextCheckpoint - std::chrono::steady_clock::now()).count();
+        return static_cast<int>(std::max<long long>(left, 0));
+    }
+
+    // Writes a copy of the slab on the background thread, so that the disk does not stall the requests.
+    // Checkpoint is skipped while the previous one is still being written.
+    void checkpoint() {
+        m_nextCheckpoint = std::chrono::steady_clock::now() + m_checkpointInterval;
+        if (m_checkpoint.valid()) {
+            if (m_checkpoint.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+            finishCheckpoint();
+        }
+        if (!m_dirty) return;
+        auto snapshot = std::make_shared<SessionSlab>(m_sessions);
+        m_dirty = false;
+        m_checkpoint = std::async(std::launch::async, [snapshot, path = m_checkpointPath]{ snapshot->checkpoint(path); });
+    }
+
+    // Waits for the background checkpoint and reports its failure.
+    void finishCheckpoint() {
+        try { m_checkpoint.get(); }
+        catch (std::runtime_error const & e) {
+            std::cerr << "Worker " << m_index << " checkpoint failed: " << e.what() << std::endl;
+            m_dirty = true; // sessions are written again with the next checkpoint
+        }
+    }
+
+    void attachIncoming() {
+        auto incoming = std::vector<std::unique_ptr<Connection>>();
+        {
+            auto lock = std::lock_guard(m_mutex);
+            incoming.swap(m_incoming);
+        }
+        for (auto & connection : incoming) {
+            auto fd = connection->fd;
+            m_poller.add(fd);
+            if (!connection->wantsRead || connection->wantsWrite)
+                m_poller.setInterest(fd, connection->wantsRead, connection->wantsWrite);
+            auto & attached = *(m_connections[fd] = std::move(connection));
+            processFrames(attached); // migrated connections may carry unanswered requests
+        }
+    }
+
+    // Reads everything available and answers the complete frames. Returns false if connection is gone.
+    bool receive(Connection & connection) {
+        std::uint8_t chunk[16 * 1024];
+        while (true) {
+            auto count = read(connection.fd, chunk, sizeof(chunk));
+            if (count > 0) {
+                connection.input.insert(connection.input.end(), chunk, chunk + count);
+                continue;
+            }
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            closeConnection(connection.fd);
+            return false;
+        }
+        return processFrames(connection);
+    }
+
+    bool processFrames(Connection & connection) {
+        auto offset = std::size_t{0};
+        while (true) {
+            if (connection.output.size() - connection.written >= g_maxPendingOutput) {
+                if (!flush(connection)) return false;
+                if (connection.output.size() - connection.written >= g_maxPendingOutput) break;
+            }
+            auto data = connection.input.data() + offset;
+            auto size = connection.input.size() - offset;
+            auto payload = std::optional<std::uint32_t>();
+            try { payload = protocol::peekFrame(data, size); }
+            catch (std::runtime_error const &) {
+                closeConnection(connection.fd);
+                return false;
+            }
+            if (!payload) break;
+
+            data += protocol::g_headerSize;
+            auto owner = getOwner(data, *payload);
+            if (owner != m_index) {
+                connection.input.erase(connection.input.begin(),
+                                       connection.input.begin() + static_cast<std::ptrdiff_t>(offset));
+                migrate(connection.fd, owner);
+                return false;
+            }
+
+            auto response = respond(data, *payload);
+            auto const & frame = response.finish();
+            connection.output.insert(connection.output.end(), frame.begin(), frame.end());
+            offset += protocol::g_headerSize + *payload;
+        }
+        connection.input.erase(connection.input.begin(), connection.input.begin() + static_cast<std::ptrdiff_t>(offset));
+        return flush(connection);
+    }
+
+    // Writes as much of the pending output as the socket accepts. Returns false if connection is gone.
+    bool flush(Connection & connection) {
+        while (connection.written < connection.output.size()) {
+            auto count = write(connection.fd, connection.output.data() + connection.written,
+                               connection.output.size() - connection.written);
+            if (count > 0) {
+                connection.written += static_cast<std::size_t>(count);
+                continue;
+            }
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            closeConnection(connection.fd);
+            return false;
+        }
+        if (connection.written == connection.output.size()) {
+            connection.output.clear();
+            connection.written = 0;
+        }
+        auto wantsRead = connection.output.size() - connection.written < g_maxPendingOutput;
+        auto wantsWrite = !connection.output.empty();
+        if (wantsRead != connection.wantsRead || wantsWrite != connection.wantsWrite) {
+            m_poller.setInterest(connection.fd, wantsRead, wantsWrite);
+            connection.wantsRead = wantsRead;
+            connection.wantsWrite = wantsWrite;
+        }
+        return true;
+    }
+
+    void closeConnection(int fd) {
+        m_poller.remove(fd);
+        close(fd);
+        m_connections.erase(fd);
+    }
+
+    void migrate(int fd, int owner) {
+        m_poller.remove(fd);
+        auto node = m_connections.extract(fd);
+        m_workers[owner]->adopt(std::move(node.mapped()));
+    }
+
+    // Returns the worker, which has to answer the frame. Malformed frames are answered locally.
+    [[nodiscard]] int getOwner(std::uint8_t const * data, std::uint32_t size) const {
+        if (size < 5 || data[0] == static_cast<std::uint8_t>(protocol::Opcode::Create)) return m_index;
+        auto session = protocol::Reader(data + 1, 4).u32();
+        auto owner = static_cast<int>(session & g_workerMask);
+        return owner < static_cast<int>(m_workers.size()) ? owner : m_index;
+    }
+
+    ////////////////////////////////////
+    ////////////////////////////////////
+
+    protocol::Writer respond(std::uint8_t const * data, std::uint32_t size) {
+        auto reader = protocol::Reader(data, size);
+        auto opcode = std::uint8_t{0};
+        try {
+            opcode = reader.u8();
+            switch (static_cast<protocol::Opcode>(opcode)) {
+                case protocol::Opcode::Create: return create(opcode, reader);
+                case protocol::Opcode::Process: return process(opcode, reader);
+                case protocol::Opcode::Get: return get(opcode, reader);
+                case protocol::Opcode::State: return state(opcode, reader);
+                case protocol::Opcode::Close: return closeSession(opcode, reader);
+                default: return reply(opcode, protocol::Status::UnknownOpcode);
+            }
+        }
+        catch (std::runtime_error const &) {
+            return reply(opcode, protocol::Status::Malformed);
+        }
+    }
+
+    protocol::Writer create(std::uint8_t opcode, protocol::Reader & reader) {
+        auto size = reader.u8();
+        auto record = SessionRecord();
+        if (size == 0) record = packSession(Game());
+        else {
+            auto player = protocol::readPlayer(reader);
+            auto state = std::vector<Game::Tile>(size * size);
+            for (auto & tile : state) tile = protocol::readTile(reader);
+            if (player == Game::Player::None) return reply(opcode, protocol::Status::Failed);
+            try { record = packSession(Game(state, player)); }
+            catch (std::runtime_error const &) { return reply(opcode, protocol::Status::Failed); }
+        }
+        if (m_sessions.size() >= g_maxSlots) return reply(opcode, protocol::Status::Failed);
+
+        auto slot = m_sessions.allocate();
+        record.generation = m_sessions.at(slot).generation;
+        record.id = makeSessionId(slot, record.generation, m_index);
+        record.lastMove = getWallClock();
+        m_sessions.at(slot) = record;
+        m_dirty = true;
+        auto response = reply(opcode, protocol::Status::Ok);
+        response.u32(record.id);
+        return response;
+    }
+
+    protocol::Writer process(std::uint8_t opcode, protocol::Reader & reader) {
+        auto record = findSession(reader.u32());
+        std::pair<int, int> from = {reader.u8(), reader.u8()};
+        std::pair<int, int> to = {reader.u8(), reader.u8()};
+        if (record == nullptr) return reply(opcode, protocol::Status::UnknownSession);
+        auto game = unpackSession(*record);
+        auto mover = game.getCurrentPlayer();
+        auto result = Game::MoveResult();
+        try { result = game.process(from, to); }
+        catch (std::runtime_error const &) { return reply(opcode, protocol::Status::Failed); }
+
+        if (result.isCorrect) {
+            auto now = getWallClock();
+            // Clock stepping back does not take any time from the mover
+            auto elapsed = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+                    now > record->lastMove ? now - record->lastMove : 0, UINT32_MAX));
+            auto & clock = mover == Game::Player::White ? record->whiteClock : record->blackClock;
+            clock = static_cast<std::uint32_t>(std::min<std::uint64_t>(std::uint64_t{clock} + elapsed, UINT32_MAX));
+            auto packed = packSession(game);
+            packed.id = record->id;
+            packed.whiteClock = record->whiteClock;
+            packed.blackClock = record->blackClock;
+            packed.plies = static_cast<std::uint16_t>(record->plies + 1);
+            packed.generation = record->generation;
+            packed.lastMove = now;
+            *record = packed;
+            m_dirty = true;
+        }
+        auto response = reply(opcode, protocol::Status::Ok);
+        protocol::writeResult(response, result);
+        return response;
+    }
+
+    protocol::Writer get(std::uint8_t opcode, protocol::Reader & reader) {
+        auto record = findSession(reader.u32());
+        std::pair<int, int> position = {reader.u8(), reader.u8()};
+        if (record == nullptr) return reply(opcode, protocol::Status::UnknownSession);
+        if (position.first >= Game::g_standardSize || position.second >= Game::g_standardSize)
+            return reply(opcode, protocol::Status::Failed);
+        auto response = reply(opcode, protocol::Status::Ok);
+        response.u8(static_cast<std::uint8_t>(getSessionTile(*record, position)));
+        return response;
+    }
+
+    protocol::Writer state(std::uint8_t opcode, protocol::Reader & reader) {
+        auto record = findSession(reader.u32());
+        if (record == nullptr) return reply(opcode, protocol::Status::UnknownSession);
+        auto response = reply(opcode, protocol::Status::Ok);
+        response.u8(record->current)
+                .u8(static_cast<std::uint8_t>(std::popcount(record->white)))
+                .u8(static_cast<std::uint8_t>(std::popcount(record->black)))
+                .u8(static_cast<std::uint8_t>(Game::g_standardSize))
+                .u16(record->plies)
+                .u32(record->whiteClock)
+                .u32(record->blackClock);
+        return response;
+    }
+
+    protocol::Writer closeSession(std::uint8_t opcode, protocol::Reader & reader) {
+        auto session = reader.u32();
+        if (findSession(session) == nullptr) return reply(opcode, protocol::Status::UnknownSession);
+        m_sessions.release(getSessionSlot(session) - 1);
+        m_dirty = true;
+        return reply(opcode, protocol::Status::Ok);
+    }
+
+    [[nodiscard]] SessionRecord * findSession(std::uint32_t session) {
+        if ((session & g_workerMask) != static_cast<std::uint32_t>(m_index) || getSessionSlot(session) == 0)
+            return nullptr;
+        auto record = m_sessions.find(getSessionSlot(session) - 1);
+        return record != nullptr && record->id == session ? record : nullptr;
+    }
+
+    ////////////////////////////////////
+    ////////////////////////////////////
+
+    int m_index;
+    std::vector<std::unique_ptr<Worker>> const & m_workers;
+    Poller m_poller;
+    int m_wake[2];
+    std::atomic<bool> m_stopping;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Connection>> m_incoming;
+    std::unordered_map<int, std::unique_ptr<Connection>> m_connections;
+    SessionSlab m_sessions;
+    std::string m_checkpointPath;
+    bool m_dirty;
+    std::future<void> m_checkpoint;
+    std::chrono::steady_clock::duration m_checkpointInterval;
+    std::chrono::steady_clock::time_point m_nextCheckpoint;
+    std::thread m_thread;
+};
+
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+/// Server
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+
+Server::Server(ServerConfig config) : m_config(std::move(config)) {
+    if (m_config.workers < 1 || m_config.workers > static_cast<int>(g_workerMask) + 1)
+        throw std::runtime_error("Server worker amount has to be between 1 and 256.");
+    if (m_config.checkpointInterval < 1)
+        throw std::runtime_error("Server checkpoint interval has to be at least 1 second.");
+    m_listenFd = net::listenOn(m_config.address);
+    net::setNonBlocking(m_listenFd);
+    makeWakePipe(m_wake);
+}
+
+Server::~Server() {
+    m_workers.clear();
+    close(m_listenFd);
+    close(m_wake[0]);
+    close(m_wake[1]);
+}
+
+void Server::run() {
+    // Workers keep the reference to this vector, thus it is not resized after they start
+    m_workers.reserve(m_config.workers);
+    for (auto i = 0; i < m_config.workers; i++) m_workers.push_back(std::make_unique<Worker>(i, m_workers, m_config));
+    auto cores = std::max(1u, std::thread::hardware_concurrency());
+    for (auto i = 0; i < m_config.workers; i++) m_workers[i]->start(i % static_cast<int>(cores));
+
+    auto poller = Poller();
+    poller.add(m_listenFd);
+    poller.add(m_wake[0]);
+    auto next = std::size_t{0};
+    auto running = true;
+    while (running) {
+        for (auto const & event : poller.wait(-1)) {
+            if (event.fd == m_wake[0]) {
+                running = false;
+                break;
+            }
+            int fd;
+            while ((fd = accept(m_listenFd, nullptr, nullptr)) >= 0) {
+                net::setNonBlocking(fd);
+                m_workers[next++ % m_workers.size()]->adopt(
+                        std::make_unique<Connection>(Connection{fd, {}, {}, 0, true, false}));
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED)
+                std::cerr << "Accepting connection failed: " << std::strerror(errno) << std::endl;
+        }
+    }
+
+    for (auto & worker : m_workers) worker->stop();
+    for (auto & worker : m_workers) worker->join();
+}
+
+void Server::stop() {
+    auto byte = char{1};
+    (void) write(m_wake[1], &byte, 1);
+}
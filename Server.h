@@ -0,0 +1,45 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_SERVER_H
+#define UTP_GAME_PROJECT_LOGIC_SERVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Configuration of the native game server
+struct ServerConfig {
+    std::string address; // "tcp:host:port" or "unix:path"
+    int workers; // Amount of event loop threads, each pinned to its own core
+    std::string checkpointDirectory; // Where the workers checkpoint their sessions, empty disables it
+    int checkpointInterval; // Seconds between the checkpoints of the changed sessions, at least 1
+};
+
+// Native game server speaking the `protocol` frames. The accepting thread spreads new
+// connections over the workers, each of them running its own event loop. Sessions are pinned
+// to the worker, which created them, and the connections follow the sessions they address.
+// Every worker keeps its sessions packed in a slab, which is periodically checkpointed into
+// "<checkpointDirectory>/worker-<index>.slab" and restored from it on the start, thus
+// the worker amount should stay the same across the restarts.
+class Server {
+
+public:
+    explicit Server(ServerConfig config);
+    ~Server();
+    Server(Server const &) = delete;
+    Server & operator = (Server const &) = delete;
+
+    // Serves the connections until `stop` is called.
+    void run();
+
+    // Requests the server to stop. Safe to call from a signal handler.
+    void stop();
+
+private:
+    class Worker;
+
+    ServerConfig m_config;
+    int m_listenFd;
+    int m_wake[2];
+    std::vector<std::unique_ptr<Worker>> m_workers;
+};
+
+#endif //UTP_GAME_PROJECT_LOGIC_SERVER_H
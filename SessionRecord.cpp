@@ -0,0 +1,44 @@
+#include <stdexcept>
+#include "SessionRecord.h"
+#include "Zobrist.h"
+
+namespace {
+
+    std::uint64_t bit(int square) {
+        return std::uint64_t{1} << square;
+    }
+
+}
+
+SessionRecord packSession(Game const & game) {
+    if (game.getSize() != Game::g_standardSize) throw std::runtime_error("Sessions support only the standard board size.");
+    auto record = SessionRecord();
+    for (auto i = 0; i < Game::g_standardSize; i++) {
+        for (auto j = 0; j < Game::g_standardSize; j++) {
+            auto tile = game.get({i, j});
+            auto square = i * Game::g_standardSize + j;
+            if (game.isPawnWhite(tile)) record.white |= bit(square);
+            else if (game.isPawnBlack(tile)) record.black |= bit(square);
+            if (tile == Game::Tile::WhiteQueen || tile == Game::Tile::BlackQueen) record.queens |= bit(square);
+        }
+    }
+    record.hash = zobrist::hash(game);
+    record.current = static_cast<std::uint8_t>(game.getCurrentPlayer());
+    return record;
+}
+
+Game unpackSession(SessionRecord const & record) {
+    auto state = std::vector<Game::Tile>(Game::g_standardSize * Game::g_standardSize);
+    for (auto i = 0; i < Game::g_standardSize; i++)
+        for (auto j = 0; j < Game::g_standardSize; j++)
+            state[i * Game::g_standardSize + j] = getSessionTile(record, {i, j});
+    return {state, static_cast<Game::Player>(record.current)};
+}
+
+Game::Tile getSessionTile(SessionRecord const & record, std::pair<int, int> const & where) {
+    auto square = bit(where.first * Game::g_standardSize + where.second);
+    auto isQueen = (record.queens & square) != 0;
+    if (record.white & square) return isQueen ? Game::Tile::WhiteQueen : Game::Tile::WhitePawn;
+    if (record.black & square) return isQueen ? Game::Tile::BlackQueen : Game::Tile::BlackPawn;
+    return Game::Tile::Blank;
+}
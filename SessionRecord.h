@@ -0,0 +1,35 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_SESSIONRECORD_H
+#define UTP_GAME_PROJECT_LOGIC_SESSIONRECORD_H
+
+#include "Game.h"
+#include <cstdint>
+
+// Packed state of a single game session. Idle games live in this form and are
+// expanded into the `Game` only for the time of processing a move.
+struct SessionRecord {
+    std::uint64_t white; // Occupied squares of the white player, bit index is row * 8 + col
+    std::uint64_t black; // Occupied squares of the black player
+    std::uint64_t queens; // Squares of both players holding a queen
+    std::uint64_t hash; // Zobrist hash of the position
+    std::uint64_t lastMove; // Wall clock milliseconds of the last accepted move or of the creation
+    std::uint32_t id; // Session identifier, 0 marks a free slot
+    std::uint32_t whiteClock; // Milliseconds spent by the white player on its moves
+    std::uint32_t blackClock; // Milliseconds spent by the black player on its moves
+    std::uint16_t plies; // Amount of accepted moves
+    std::uint8_t current; // Player to move
+    std::uint8_t generation; // Bumped whenever the slot is released, kept in the identifier to tell apart its reuses
+    std::uint8_t reserved[8];
+};
+
+static_assert(sizeof(SessionRecord) == 64, "Session record is meant to fill a single cache line.");
+
+// Packs the standard sized board. Clock state and identifier are left for the caller.
+[[nodiscard]] SessionRecord packSession(Game const & game);
+
+// Restores the game stored in the record.
+[[nodiscard]] Game unpackSession(SessionRecord const & record);
+
+// Reads the tile straight from the record without expanding it.
+[[nodiscard]] Game::Tile getSessionTile(SessionRecord const & record, std::pair<int, int> const & where);
+
+#endif //UTP_GAME_PROJECT_LOGIC_SESSIONRECORD_H
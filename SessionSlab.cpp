@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+#include "SessionSlab.h"
+
+namespace {
+
+    constexpr char g_magic[8] = {'U', 'T', 'P', 'S', 'L', 'A', 'B', '1'};
+
+    std::runtime_error systemError(std::string const & what) {
+        return std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+}
+
+SessionSlab::SessionSlab() : m_size(0) {}
+
+std::uint32_t SessionSlab::allocate() {
+    m_size++;
+    if (!m_free.empty()) {
+        auto slot = m_free.back();
+        m_free.pop_back();
+        return slot;
+    }
+    m_records.push_back(SessionRecord());
+    return static_cast<std::uint32_t>(m_records.size() - 1);
+}
+
+void SessionSlab::release(std::uint32_t slot) {
+    auto generation = static_cast<std::uint8_t>(m_records[slot].generation + 1);
+    m_records[slot] = SessionRecord();
+    m_records[slot].generation = generation;
+    m_free.push_back(slot);
+    m_size--;
+}
+
+SessionRecord & SessionSlab::at(std::uint32_t slot) {
+    return m_records[slot];
+}
+
+SessionRecord * SessionSlab::find(std::uint32_t slot) {
+    if (slot >= m_records.size() || m_records[slot].id == 0) return nullptr;
+    return &m_records[slot];
+}
+
+std::size_t SessionSlab::size() const {
+    return m_size;
+}
+
+std::uint32_t SessionSlab::slots() const {
+    return static_cast<std::uint32_t>(m_records.size());
+}
+
+void SessionSlab::checkpoint(std::string const & path) const {
+    auto header = FileHeader();
+    std::memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.recordSize = sizeof(SessionRecord);
+    header.slots = static_cast<std::uint32_t>(m_records.size());
+    header.timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    auto recordsSize = m_records.size() * sizeof(SessionRecord);
+    auto size = sizeof(FileHeader) + recordsSize;
+
+    // Written aside and renamed, so that a crash in the middle never leaves a torn checkpoint
+    auto temporary = path + ".tmp";
+    auto fd = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw systemError("Could not create checkpoint " + temporary);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        throw systemError("Could not resize checkpoint " + temporary);
+    }
+    auto mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) throw systemError("Could not map checkpoint " + temporary);
+    auto bytes = static_cast<char *>(mapping);
+    std::memcpy(bytes, &header, sizeof(FileHeader));
+    if (recordsSize > 0) std::memcpy(bytes + sizeof(FileHeader), m_records.data(), recordsSize);
+    auto synced = msync(mapping, size, MS_SYNC) == 0;
+    munmap(mapping, size);
+    if (!synced) throw systemError("Could not flush checkpoint " + temporary);
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) throw systemError("Could not replace checkpoint " + path);
+
+    // Rename itself is durable only once the directory entry reaches the disk
+    auto separator = path.find_last_of('/');
+    auto directory = separator == std::string::npos ? std::string(".") : path.substr(0, std::max<std::size_t>(separator, 1));
+    auto directoryFd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directoryFd < 0) throw systemError("Could not open checkpoint directory " + directory);
+    auto directorySynced = fsync(directoryFd) == 0;
+    close(directoryFd);
+    if (!directorySynced) throw systemError("Could not flush checkpoint directory " + directory);
+}
+
+bool SessionSlab::restore(std::string const & path) {
+    struct stat info{};
+    if (stat(path.c_str(), &info) != 0 && errno == ENOENT) return false;
+    auto file = MappedFile(path, "checkpoint");
+    auto header = FileHeader();
+    auto matches = file.hasHeader(g_magic, sizeof(g_magic), sizeof(FileHeader));
+    if (matches) {
+        std::memcpy(&header, file.data(), sizeof(FileHeader));
+        matches = header.recordSize == sizeof(SessionRecord) &&
+                  file.size() == sizeof(FileHeader) + std::size_t{header.slots} * sizeof(SessionRecord);
+    }
+    if (!matches) throw std::runtime_error("Checkpoint " + path + " does not match the session record layout.");
+    auto records = reinterpret_cast<SessionRecord const *>(file.data() + sizeof(FileHeader));
+    m_records.assign(records, records + header.slots);
+
+    m_free.clear();
+    m_size = 0;
+    for (auto slot = header.slots; slot-- > 0;) {
+        if (m_records[slot].id == 0) m_free.push_back(slot);
+        else m_size++;
+    }
+    return true;
+}
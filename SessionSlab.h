@@ -0,0 +1,56 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_SESSIONSLAB_H
+#define UTP_GAME_PROJECT_LOGIC_SESSIONSLAB_H
+
+#include "SessionRecord.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Contiguous storage of the session records addressed by their slot. The whole slab
+// can be checkpointed into a memory-mapped file and mapped back in after a restart.
+class SessionSlab {
+
+public:
+
+    // Layout of the checkpoint file header, it is followed by `slots` records.
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t recordSize;
+        std::uint32_t slots;
+        std::uint64_t timestamp;
+        std::uint8_t reserved[40];
+    };
+
+    SessionSlab();
+
+    // Returns the free slot, which is marked as occupied by the caller setting the record id.
+    [[nodiscard]] std::uint32_t allocate();
+
+    // Frees the slot and bumps its generation.
+    void release(std::uint32_t slot);
+
+    // Returns the record stored in the allocated slot.
+    [[nodiscard]] SessionRecord & at(std::uint32_t slot);
+
+    // Returns the occupied record stored in the slot or null.
+    [[nodiscard]] SessionRecord * find(std::uint32_t slot);
+    [[nodiscard]] std::size_t size() const;
+
+    // Returns the amount of slots including the free ones.
+    [[nodiscard]] std::uint32_t slots() const;
+
+    // Atomically and durably replaces the file with the current content of the slab.
+    void checkpoint(std::string const & path) const;
+
+    // Replaces the content of the slab with the checkpoint. Returns false if there is no such file.
+    bool restore(std::string const & path);
+
+private:
+    std::vector<SessionRecord> m_records;
+    std::vector<std::uint32_t> m_free;
+    std::size_t m_size;
+};
+
+static_assert(sizeof(SessionSlab::FileHeader) == 64, "Checkpoint header has to keep the records aligned.");
+
+#endif //UTP_GAME_PROJECT_LOGIC_SESSIONSLAB_H
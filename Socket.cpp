@@ -0,0 +1,167 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Protocol.h"
+#include "Socket.h"
+
+namespace net {
+
+    ///////////////////////////////////////////////////////
+    /// Helper Functions
+    ///////////////////////////////////////////////////////
+
+
+    namespace {
+
+        std::runtime_error systemError(std::string const & what) {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        sockaddr_un unixAddress(std::string const & path) {
+            auto address = sockaddr_un();
+            address.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(address.sun_path))
+                throw std::runtime_error("Unix socket path " + path + " is too long.");
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return address;
+        }
+
+        // Splits "host:port" and resolves it into the list of candidate addresses.
+        addrinfo * resolve(std::string const & hostPort, bool passive) {
+            auto colon = hostPort.rfind(':');
+            if (colon == std::string::npos) throw std::runtime_error("TCP address " + hostPort + " has no port.");
+            auto host = hostPort.substr(0, colon);
+            auto port = hostPort.substr(colon + 1);
+            auto hints = addrinfo();
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = passive ? AI_PASSIVE : 0;
+            addrinfo * result = nullptr;
+            auto code = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+            if (code != 0) throw std::runtime_error("Could not resolve " + hostPort + ": " + gai_strerror(code));
+            return result;
+        }
+
+        void setNoDelay(int fd) {
+            auto enabled = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        }
+
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Connection Setup
+    ///////////////////////////////////////////////////////
+
+
+    int listenOn(std::string const & address) {
+        if (address.starts_with("unix:")) {
+            auto path = address.substr(5);
+            auto local = unixAddress(path);
+            auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0) throw systemError("Could not create unix socket");
+            // Only a socket left over by the previous run is replaced, any other file makes the bind fail
+            struct stat info{};
+            if (lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(path.c_str());
+            if (bind(fd, reinterpret_cast<sockaddr *>(&local), sizeof(local)) != 0 || listen(fd, SOMAXCONN) != 0) {
+                close(fd);
+                throw systemError("Could not listen on " + address);
+            }
+            return fd;
+        }
+        if (!address.starts_with("tcp:")) throw std::runtime_error("Unknown address scheme of " + address + ".");
+
+        auto candidates = resolve(address.substr(4), true);
+        auto fd = -1;
+        for (auto it = candidates; it != nullptr && fd < 0; it = it->ai_next) {
+            fd = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+            if (fd < 0) continue;
+            auto reuse = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (bind(fd, it->ai_addr, it->ai_addrlen) != 0 || listen(fd, SOMAXCONN) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(candidates);
+        if (fd < 0) throw systemError("Could not listen on " + address);
+        return fd;
+    }
+
+    int connectTo(std::string const & address) {
+        if (address.starts_with("unix:")) {
+            auto remote = unixAddress(address.substr(5));
+            auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0) throw systemError("Could not create unix socket");
+            if (connect(fd, reinterpret_cast<sockaddr *>(&remote), sizeof(remote)) != 0) {
+                close(fd);
+                throw systemError("Could not connect to " + address);
+            }
+            return fd;
+        }
+        if (!address.starts_with("tcp:")) throw std::runtime_error("Unknown address scheme of " + address + ".");
+
+        auto candidates = resolve(address.substr(4), false);
+        auto fd = -1;
+        for (auto it = candidates; it != nullptr && fd < 0; it = it->ai_next) {
+            fd = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+            if (fd < 0) continue;
+            if (connect(fd, it->ai_addr, it->ai_addrlen) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(candidates);
+        if (fd < 0) throw systemError("Could not connect to " + address);
+        setNoDelay(fd);
+        return fd;
+    }
+
+    void setNonBlocking(int fd) {
+        auto flags = fcntl(fd, F_GETFL, 0);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) throw systemError("Could not set non-blocking mode");
+        setNoDelay(fd); // fails harmlessly on unix sockets
+    }
+
+
+    ///////////////////////////////////////////////////////
+    /// Blocking I/O
+    ///////////////////////////////////////////////////////
+
+
+    void writeAll(int fd, std::uint8_t const * data, std::size_t size) {
+        while (size > 0) {
+            auto written = write(fd, data, size);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) throw systemError("Could not write to socket");
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    std::vector<std::uint8_t> readFrame(int fd) {
+        auto buffer = std::vector<std::uint8_t>(protocol::g_headerSize);
+        auto received = std::size_t{0};
+        while (true) {
+            auto payload = protocol::peekFrame(buffer.data(), received);
+            if (payload) return {buffer.begin() + protocol::g_headerSize, buffer.end()};
+            if (received == protocol::g_headerSize)
+                buffer.resize(protocol::g_headerSize + protocol::Reader(buffer.data(), received).u32());
+            auto count = read(fd, buffer.data() + received, buffer.size() - received);
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0) throw systemError("Could not read from socket");
+            if (count == 0) throw std::runtime_error("Connection closed by the server.");
+            received += static_cast<std::size_t>(count);
+        }
+    }
+
+}
@@ -0,0 +1,23 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_SOCKET_H
+#define UTP_GAME_PROJECT_LOGIC_SOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Thin wrappers over the POSIX sockets. Addresses are given either as
+// "tcp:host:port" or as "unix:path". All the failures are reported by exceptions.
+namespace net {
+
+    int listenOn(std::string const & address);
+    int connectTo(std::string const & address);
+    void setNonBlocking(int fd);
+
+    // Blocking helpers used by the clients.
+    void writeAll(int fd, std::uint8_t const * data, std::size_t size);
+    std::vector<std::uint8_t> readFrame(int fd);
+
+}
+
+#endif //UTP_GAME_PROJECT_LOGIC_SOCKET_H
@@ -0,0 +1,48 @@
+#include <array>
+#include <stdexcept>
+#include "Zobrist.h"
+
+namespace zobrist {
+
+    namespace {
+
+        constexpr int g_tileKinds = 4; // every tile except the blank one
+        constexpr int g_squares = Game::g_standardSize * Game::g_standardSize;
+
+        constexpr std::uint64_t splitMix(std::uint64_t & state) {
+            auto z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        constexpr auto g_keys = []{
+            auto keys = std::array<std::uint64_t, g_tileKinds * g_squares + 1>();
+            auto state = std::uint64_t{0x5554502D47414D45ull};
+            for (auto & key : keys) key = splitMix(state);
+            return keys;
+        }();
+
+    }
+
+    std::uint64_t tileKey(Game::Tile tile, int square) {
+        return g_keys[(static_cast<int>(tile) - 1) * g_squares + square];
+    }
+
+    std::uint64_t blackToMoveKey() {
+        return g_keys.back();
+    }
+
+    std::uint64_t hash(Game const & game) {
+        if (game.getSize() != Game::g_standardSize) throw std::runtime_error("Hashing supports only the standard board size.");
+        auto result = game.getCurrentPlayer() == Game::Player::Black ? blackToMoveKey() : std::uint64_t{0};
+        for (auto i = 0; i < Game::g_standardSize; i++) {
+            for (auto j = 0; j < Game::g_standardSize; j++) {
+                auto tile = game.get({i, j});
+                if (tile != Game::Tile::Blank) result ^= tileKey(tile, i * Game::g_standardSize + j);
+            }
+        }
+        return result;
+    }
+
+}
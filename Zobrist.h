@@ -0,0 +1,19 @@
+#ifndef UTP_GAME_PROJECT_LOGIC_ZOBRIST_H
+#define UTP_GAME_PROJECT_LOGIC_ZOBRIST_H
+
+#include "Game.h"
+#include <cstdint>
+
+// Position hashing shared by the session records and the opening book. The keys
+// are generated from the fixed seed, so hashes stay valid across the builds and the restarts.
+namespace zobrist {
+
+    [[nodiscard]] std::uint64_t tileKey(Game::Tile tile, int square);
+    [[nodiscard]] std::uint64_t blackToMoveKey();
+
+    // Hashes the standard sized board together with the player to move.
+    [[nodiscard]] std::uint64_t hash(Game const & game);
+
+}
+
+#endif //UTP_GAME_PROJECT_LOGIC_ZOBRIST_H
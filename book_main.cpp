@@ -0,0 +1,89 @@
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "Engine.h"
+#include "Nnue.h"
+#include "OpeningBook.h"
+
+// Offline builder of the opening book. Recorded games are read one per line as the space
+// separated moves in the "fromRow,fromCol-toRow,toCol" form, empty lines and lines starting
+// with '#' are skipped. Afterwards the engine analyses the resulting tree from the initial setup.
+
+constexpr std::uint16_t g_analysisWeight = 4;
+
+std::optional<std::vector<Game::Move>> parseGame(std::string const & line) {
+    auto moves = std::vector<Game::Move>();
+    auto stream = std::istringstream(line);
+    auto token = std::string();
+    while (stream >> token) {
+        auto move = Game::Move();
+        char comma1, dash, comma2;
+        auto tokenStream = std::istringstream(token);
+        tokenStream >> move.from.first >> comma1 >> move.from.second >> dash >> move.to.first >> comma2 >> move.to.second;
+        if (!tokenStream || comma1 != ',' || dash != '-' || comma2 != ',') return std::nullopt;
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <output book> [--games <file>] [--plies <n>] "
+                     "[--analysis-plies <n>] [--depth <n>] [--network <file>]" << std::endl;
+        return 1;
+    }
+    auto output = std::string(argv[1]);
+    auto gamesPath = std::string();
+    auto networkPath = std::string();
+    auto plies = 16;
+    auto analysisPlies = 6;
+    auto depth = 4;
+    for (auto i = 2; i + 1 < argc; i += 2) {
+        auto option = std::string(argv[i]);
+        if (option == "--games") gamesPath = argv[i + 1];
+        else if (option == "--plies") plies = std::stoi(argv[i + 1]);
+        else if (option == "--analysis-plies") analysisPlies = std::stoi(argv[i + 1]);
+        else if (option == "--depth") depth = std::stoi(argv[i + 1]);
+        else if (option == "--network") networkPath = argv[i + 1];
+        else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        auto builder = OpeningBookBuilder();
+        if (!gamesPath.empty()) {
+            auto file = std::ifstream(gamesPath);
+            if (!file) throw std::runtime_error("Could not open games file " + gamesPath + ".");
+            auto line = std::string();
+            auto number = 0;
+            auto added = 0;
+            while (std::getline(file, line)) {
+                number++;
+                if (line.empty() || line.front() == '#') continue;
+                auto moves = parseGame(line);
+                if (!moves) std::cerr << "Line " << number << " is not a valid game, skipping." << std::endl;
+                else if (!builder.addGame(*moves, plies))
+                    std::cerr << "Line " << number << " contains an illegal move, kept the moves before it." << std::endl;
+                else added++;
+            }
+            std::cout << "Added " << added << " recorded games." << std::endl;
+        }
+
+        auto network = networkPath.empty() ? nullptr : std::make_unique<nnue::Network>(networkPath);
+        auto engine = Engine(network.get());
+        builder.addAnalysis(engine, analysisPlies, depth, g_analysisWeight);
+
+        auto entries = builder.getEntries();
+        OpeningBook::write(output, entries);
+        std::cout << "Written " << entries.size() << " book moves to " << output << "." << std::endl;
+    }
+    catch (std::exception const & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
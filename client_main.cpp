@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "Protocol.h"
+#include "Socket.h"
+
+// Load testing client of the native game server. Every connection plays its own set of
+// games with random diagonal probes and the total throughput is reported at the end.
+
+// Aggregated statistics of all the connections
+struct Statistics {
+    std::atomic<long> requests{0};
+    std::atomic<long> moves{0};
+    std::atomic<long> finished{0};
+    std::atomic<long> failures{0};
+};
+
+// Sends a single request and returns the reader over its response, positioned behind the status.
+protocol::Reader exchange(int fd, protocol::Writer & request, std::vector<std::uint8_t> & response) {
+    auto const & frame = request.finish();
+    net::writeAll(fd, frame.data(), frame.size());
+    response = net::readFrame(fd);
+    auto reader = protocol::Reader(response.data(), response.size());
+    reader.u8(); // echoed opcode
+    if (static_cast<protocol::Status>(reader.u8()) != protocol::Status::Ok)
+        throw std::runtime_error("Server rejected the request.");
+    return reader;
+}
+
+void play(std::string const & address, int games, int moves, unsigned seed, Statistics & statistics) {
+    auto random = std::mt19937(seed);
+    auto fd = net::connectTo(address);
+    auto response = std::vector<std::uint8_t>();
+    try {
+        auto sessions = std::vector<std::uint32_t>();
+        for (auto i = 0; i < games; i++) {
+            auto request = protocol::Writer();
+            request.u8(static_cast<std::uint8_t>(protocol::Opcode::Create)).u8(0);
+            sessions.push_back(exchange(fd, request, response).u32());
+            statistics.requests++;
+        }
+
+        // Blocked positions are given up after too many rejected probes
+        auto played = std::vector<int>(sessions.size(), 0);
+        auto probes = std::vector<long>(sessions.size(), 0);
+        auto active = sessions.size();
+        while (active > 0) {
+            for (auto i = 0; i < sessions.size(); i++) {
+                if (played[i] >= moves) continue;
+                if (++probes[i] > 1000L * moves) {
+                    played[i] = moves;
+                    active--;
+                    continue;
+                }
+                auto row = static_cast<int>(random() % 8);
+                auto col = static_cast<int>(random() % 8);
+                auto distance = static_cast<int>(random() % 2) + 1;
+                auto toRow = row + (random() % 2 ? distance : -distance);
+                auto toCol = col + (random() % 2 ? distance : -distance);
+                if (toRow < 0 || toRow >= 8 || toCol < 0 || toCol >= 8) continue;
+
+                auto request = protocol::Writer();
+                request.u8(static_cast<std::uint8_t>(protocol::Opcode::Process)).u32(sessions[i])
+                       .u8(row).u8(col).u8(toRow).u8(toCol);
+                auto reader = exchange(fd, request, response);
+                auto result = protocol::readResult(reader);
+                statistics.requests++;
+                if (!result.isCorrect) continue;
+                statistics.moves++;
+                if (++played[i] >= moves || result.winner != Game::Player::None) {
+                    if (result.winner != Game::Player::None) statistics.finished++;
+                    played[i] = moves;
+                    active--;
+                }
+            }
+        }
+
+        for (auto session : sessions) {
+            auto request = protocol::Writer();
+            request.u8(static_cast<std::uint8_t>(protocol::Opcode::Close)).u32(session);
+            exchange(fd, request, response);
+            statistics.requests++;
+        }
+    }
+    catch (std::exception const & e) {
+        std::cerr << e.what() << std::endl;
+        statistics.failures++;
+    }
+    close(fd);
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <tcp:host:port|unix:path> [connections] [games] [moves]" << std::endl;
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    auto address = std::string(argv[1]);
+    auto connections = argc > 2 ? std::stoi(argv[2]) : 4;
+    auto games = argc > 3 ? std::stoi(argv[3]) : 16;
+    auto moves = argc > 4 ? std::stoi(argv[4]) : 40;
+
+    auto statistics = Statistics();
+    auto start = std::chrono::steady_clock::now();
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < connections; i++)
+        threads.emplace_back([&, i]{
+            try { play(address, games, moves, static_cast<unsigned>(i + 1), statistics); }
+            catch (std::exception const & e) {
+                std::cerr << e.what() << std::endl;
+                statistics.failures++;
+            }
+        });
+    for (auto & thread : threads) thread.join();
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Requests: " << statistics.requests << ", accepted moves: " << statistics.moves
+              << ", finished games: " << statistics.finished << ", failed connections: " << statistics.failures
+              << std::endl;
+    std::cout << "Elapsed: " << seconds << " s, " << static_cast<double>(statistics.requests) / seconds
+              << " requests/s" << std::endl;
+    return statistics.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "RuleEngine.h"
+
+// Differential fuzzer of the rule engines. Random positions are reached by playing random legal
+// moves from the initial setup, then a random (from, to) probe is processed by every engine and
+// the outcomes are compared with the reference. Mismatching positions are minimized by removing
+// pawns while the mismatch persists. The throughput of every engine is measured on the same cases.
+
+constexpr int g_reportedMismatches = 5;
+
+// Single probe of the position
+struct Case {
+    std::vector<Game::Tile> state;
+    Game::Player player;
+    std::pair<int, int> from;
+    std::pair<int, int> to;
+};
+
+// Everything observable about processing a single probe
+struct Outcome {
+    bool threw;
+    Game::MoveResult result;
+    std::vector<Game::Tile> board;
+    Game::Player current;
+    int white;
+    int black;
+};
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+std::vector<Game::Tile> flatten(Game const & game) {
+    auto state = std::vector<Game::Tile>();
+    for (auto i = 0; i < Game::g_standardSize; i++)
+        for (auto j = 0; j < Game::g_standardSize; j++)
+            state.push_back(game.get({i, j}));
+    return state;
+}
+
+Case generate(std::mt19937 & random, int maxPlies) {
+    auto game = Game();
+    auto plies = static_cast<int>(random() % (maxPlies + 1));
+    for (auto i = 0; i < plies; i++) {
+        auto moves = game.getMoves();
+        if (moves.empty()) break;
+        auto const & move = moves[random() % moves.size()];
+        auto child = game;
+        if (child.process(move.from, move.to).winner != Game::Player::None) break;
+        game = std::move(child);
+    }
+
+    auto result = Case{flatten(game), game.getCurrentPlayer(), {0, 0}, {0, 0}};
+    auto kind = random() % 10;
+    auto moves = game.getMoves();
+    if (kind < 5 && !moves.empty()) { // legal move
+        auto const & move = moves[random() % moves.size()];
+        result.from = move.from;
+        result.to = move.to;
+    }
+    else if (kind < 9) { // any tile of the board, mostly rejected moves
+        result.from = {static_cast<int>(random() % Game::g_standardSize), static_cast<int>(random() % Game::g_standardSize)};
+        result.to = {static_cast<int>(random() % Game::g_standardSize), static_cast<int>(random() % Game::g_standardSize)};
+    }
+    else { // positions around the board edge, some of them outside
+        auto coordinate = [&random]{ return static_cast<int>(random() % (Game::g_standardSize + 2)) - 1; };
+        result.from = {coordinate(), coordinate()};
+        result.to = {coordinate(), coordinate()};
+    }
+    return result;
+}
+
+Outcome run(RuleEngine & engine, Case const & probe) {
+    auto outcome = Outcome();
+    engine.load(probe.state, probe.player);
+    try { outcome.result = engine.process(probe.from, probe.to); }
+    catch (std::runtime_error const &) { outcome.threw = true; }
+    auto game = engine.getGame();
+    outcome.board = flatten(game);
+    outcome.current = game.getCurrentPlayer();
+    outcome.white = game.getWhitePawnsAmount();
+    outcome.black = game.getBlackPawnsAmount();
+    return outcome;
+}
+
+// Returns the description of the first difference, empty if the outcomes match.
+std::string compare(Outcome const & expected, Outcome const & actual) {
+    if (expected.threw != actual.threw) return "exception";
+    if (!expected.threw) {
+        if (expected.result.isCorrect != actual.result.isCorrect) return "isCorrect";
+        if (expected.result.isQueen != actual.result.isQueen) return "isQueen";
+        if (expected.result.winner != actual.result.winner) return "winner";
+        if (expected.result.takenPawns != actual.result.takenPawns) return "takenPawns";
+        if (expected.result.message != actual.result.message) return "message";
+    }
+    if (expected.board != actual.board) return "board";
+    if (expected.current != actual.current) return "current player";
+    if (expected.white != actual.white || expected.black != actual.black) return "pawn amounts";
+    return "";
+}
+
+bool isMismatch(RuleEngine & reference, RuleEngine & engine, Case const & probe) {
+    return !compare(run(reference, probe), run(engine, probe)).empty();
+}
+
+// Greedily removes pawns and demotes queens as long as the mismatch stays.
+Case minimize(RuleEngine & reference, RuleEngine & engine, Case probe) {
+    auto progress = true;
+    while (progress) {
+        progress = false;
+        for (auto & tile : probe.state) {
+            if (tile == Game::Tile::Blank) continue;
+            auto original = tile;
+            for (auto replacement : {Game::Tile::Blank, Game::Tile::WhitePawn, Game::Tile::BlackPawn}) {
+                if (replacement != Game::Tile::Blank &&
+                    !(original == Game::Tile::WhiteQueen && replacement == Game::Tile::WhitePawn) &&
+                    !(original == Game::Tile::BlackQueen && replacement == Game::Tile::BlackPawn)) continue;
+                tile = replacement;
+                if (isMismatch(reference, engine, probe)) {
+                    progress = true;
+                    break;
+                }
+                tile = original;
+            }
+        }
+    }
+    return probe;
+}
+
+std::string describe(Outcome const & outcome) {
+    if (outcome.threw) return "threw";
+    auto stream = std::ostringstream();
+    stream << "isCorrect=" << outcome.result.isCorrect << " isQueen=" << outcome.result.isQueen
+           << " winner=" << static_cast<int>(outcome.result.winner) << " taken=[";
+    for (auto const & p : outcome.result.takenPawns) stream << " " << p.first << "," << p.second;
+    stream << " ] message=\"" << outcome.result.message << "\"";
+    return stream.str();
+}
+
+void report(RuleEngine & reference, RuleEngine & engine, Case const & probe) {
+    auto reduced = minimize(reference, engine, probe);
+    auto expected = run(reference, reduced);
+    auto actual = run(engine, reduced);
+    std::cout << "Mismatch of " << engine.getName() << " in " << compare(expected, actual) << ", player "
+              << static_cast<int>(reduced.player) << " probes " << reduced.from.first << "," << reduced.from.second
+              << "-" << reduced.to.first << "," << reduced.to.second << std::endl;
+    for (auto i = 0; i < Game::g_standardSize; i++) {
+        std::cout << "    ";
+        for (auto j = 0; j < Game::g_standardSize; j++) std::cout << ".bwBW"[static_cast<int>(reduced.state[i * Game::g_standardSize + j])];
+        std::cout << std::endl;
+    }
+    std::cout << "    expected: " << describe(expected) << std::endl;
+    std::cout << "    actual:   " << describe(actual) << std::endl;
+}
+
+////////////////////////////////////////////////
+////////////////////////////////////////////////
+
+int main(int argc, char ** argv) {
+    auto count = argc > 1 ? std::stoi(argv[1]) : 20000;
+    auto seed = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 1u;
+    auto maxPlies = argc > 3 ? std::stoi(argv[3]) : 40;
+
+    auto engines = std::vector<std::unique_ptr<RuleEngine>>();
+    engines.push_back(std::make_unique<ReferenceRuleEngine>());
+    engines.push_back(std::make_unique<CopyingRuleEngine>());
+    engines.push_back(std::make_unique<PackedRuleEngine>());
+    auto & reference = *engines.front();
+
+    auto random = std::mt19937(seed);
+    auto cases = std::vector<Case>();
+    for (auto i = 0; i < count; i++) cases.push_back(generate(random, maxPlies));
+    std::cout << "Generated " << cases.size() << " probes with seed " << seed << "." << std::endl;
+
+    // Throughput is measured on a separate pass, so that capturing the outcomes does not skew it.
+    // Setting up the positions is timed on its own and subtracted, only the processing is compared.
+    auto referenceRate = 0.0;
+    for (auto const & engine : engines) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto const & probe : cases) engine->load(probe.state, probe.player);
+        auto loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        auto checksum = std::size_t{0};
+        start = std::chrono::steady_clock::now();
+        for (auto const & probe : cases) {
+            engine->load(probe.state, probe.player);
+            try { checksum += engine->process(probe.from, probe.to).takenPawns.size() + 1; }
+            catch (std::runtime_error const &) {}
+        }
+        auto totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        auto seconds = std::max(totalSeconds - loadSeconds, 1e-9);
+        auto rate = static_cast<double>(cases.size()) / seconds;
+        if (engine.get() == &reference) referenceRate = rate;
+        std::cout << engine->getName() << ": " << rate << " probes/s, " << rate / referenceRate
+                  << "x reference (checksum " << checksum << ")" << std::endl;
+    }
+
+    auto failed = false;
+    for (auto i = std::size_t{1}; i < engines.size(); i++) {
+        auto mismatches = 0;
+        for (auto const & probe : cases) {
+            if (!isMismatch(reference, *engines[i], probe)) continue;
+            if (mismatches++ < g_reportedMismatches) report(reference, *engines[i], probe);
+        }
+        std::cout << engines[i]->getName() << ": " << mismatches << " mismatches" << std::endl;
+        failed = failed || mismatches > 0;
+    }
+    return failed ? 1 : 0;
+}
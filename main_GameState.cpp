@@ -2,15 +2,27 @@
 // Created by Kuuba Puacz on 29/10/2024.
 //
 
+#include <algorithm>
 #include <iostream>
 #include "main_GameState.h"
 #include "jni.h"
+#include "Engine.h"
 #include "Game.h"
+#include "OpeningBook.h"
 #include "util.h"
 
 // Global default GameState
 std::unique_ptr<Game> g_state;
 
+// Opening book loaded on the Java side request
+std::unique_ptr<OpeningBook> g_book;
+
+// Evaluation network loaded on the Java side request
+std::unique_ptr<nnue::Network> g_network;
+
+// Engine shared by the analysis calls, set up again whenever the book or the network changes
+Engine g_engine;
+
 JNIEXPORT void JNICALL Java_main_GameState_init__(JNIEnv * env, jobject self) {
     g_state = std::make_unique<Game>();
 }
@@ -54,4 +66,71 @@ JNIEXPORT jint JNICALL Java_main_GameState_getWhitePawnsAmount(JNIEnv * env, job
 
 JNIEXPORT jint JNICALL Java_main_GameState_getBlackPawnsAmount(JNIEnv * env, jobject self) {
     return static_cast<jint>(g_state->getBlackPawnsAmount());
+}
+
+JNIEXPORT jboolean JNICALL Java_main_GameState_loadBook(JNIEnv * env, jobject self, jstring jPath) {
+    auto raw = env->GetStringUTFChars(jPath, nullptr);
+    auto path = std::string(raw);
+    env->ReleaseStringUTFChars(jPath, raw);
+    try { g_book = std::make_unique<OpeningBook>(path); }
+    catch (std::runtime_error const & e) {
+        std::cerr << e.what() << std::endl;
+        return JNI_FALSE;
+    }
+    g_engine = Engine(g_network.get(), g_book.get());
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL Java_main_GameState_loadNetwork(JNIEnv * env, jobject self, jstring jPath) {
+    auto raw = env->GetStringUTFChars(jPath, nullptr);
+    auto path = std::string(raw);
+    env->ReleaseStringUTFChars(jPath, raw);
+    try { g_network = std::make_unique<nnue::Network>(path); }
+    catch (std::runtime_error const & e) {
+        std::cerr << e.what() << std::endl;
+        return JNI_FALSE;
+    }
+    g_engine = Engine(g_network.get(), g_book.get());
+    return JNI_TRUE;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_bookMove(JNIEnv * env, jobject self) {
+    if (g_book == nullptr) return nullptr;
+    auto move = std::optional<Game::Move>();
+    try { move = g_book->getMove(*g_state); }
+    catch (std::runtime_error const & e) {
+        std::cerr << e.what() << std::endl;
+        return nullptr;
+    }
+    if (!move) return nullptr;
+    return java::moveToJava(env, *move);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_analyse(JNIEnv * env, jobject self, jint depth, jint lines) {
+    auto results = std::vector<Engine::Line>();
+    try { results = g_engine.analyse(*g_state, depth, lines); }
+    catch (std::runtime_error const & e) {
+        std::cerr << e.what() << std::endl;
+        return nullptr;
+    }
+    auto array = env->NewObjectArray(static_cast<jsize>(results.size()),
+                                     env->FindClass("main/GameAnalysisLine"), nullptr);
+    for (auto i = 0; i < results.size(); i++)
+        env->SetObjectArrayElement(array, i, java::lineToJava(env, results[i]));
+    return array;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_annotate(JNIEnv * env, jobject self,
+                                                            jobjectArray jMoves, jint depth) {
+    auto results = std::vector<Engine::Annotation>();
+    try { results = g_engine.annotate(Game(), java::movesToCpp(env, jMoves), depth); }
+    catch (std::runtime_error const & e) {
+        std::cerr << e.what() << std::endl;
+        return nullptr;
+    }
+    auto array = env->NewObjectArray(static_cast<jsize>(results.size()),
+                                     env->FindClass("main/GameAnnotation"), nullptr);
+    for (auto i = 0; i < results.size(); i++)
+        env->SetObjectArrayElement(array, i, java::annotationToJava(env, results[i]));
+    return array;
 }
\ No newline at end of file
@@ -71,6 +71,46 @@ JNIEXPORT jint JNICALL Java_main_GameState_getWhitePawnsAmount
 JNIEXPORT jint JNICALL Java_main_GameState_getBlackPawnsAmount
         (JNIEnv *, jobject);
 
+/*
+ * Class:     main_GameState
+ * Method:    loadBook
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_main_GameState_loadBook
+        (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     main_GameState
+ * Method:    loadNetwork
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_main_GameState_loadNetwork
+        (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     main_GameState
+ * Method:    bookMove
+ * Signature: ()[Lmain/GamePosition;
+ */
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_bookMove
+        (JNIEnv *, jobject);
+
+/*
+ * Class:     main_GameState
+ * Method:    analyse
+ * Signature: (II)[Lmain/GameAnalysisLine;
+ */
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_analyse
+        (JNIEnv *, jobject, jint, jint);
+
+/*
+ * Class:     main_GameState
+ * Method:    annotate
+ * Signature: ([Lmain/GamePosition;I)[Lmain/GameAnnotation;
+ */
+JNIEXPORT jobjectArray JNICALL Java_main_GameState_annotate
+        (JNIEnv *, jobject, jobjectArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
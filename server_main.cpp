@@ -0,0 +1,40 @@
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Server.h"
+
+// Server instance stopped by the termination signals
+Server * g_server = nullptr;
+
+void onSignal(int) {
+    if (g_server != nullptr) g_server->stop();
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <tcp:host:port|unix:path> [workers] [checkpoint directory] [checkpoint seconds]" << std::endl;
+        return 1;
+    }
+    auto config = ServerConfig();
+    config.address = argv[1];
+    config.workers = argc > 2 ? std::stoi(argv[2]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    config.checkpointDirectory = argc > 3 ? argv[3] : "";
+    config.checkpointInterval = argc > 4 ? std::stoi(argv[4]) : 5;
+
+    try {
+        auto server = Server(config);
+        g_server = &server;
+        std::signal(SIGPIPE, SIG_IGN);
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::cout << "Serving on " << config.address << " with " << config.workers << " workers." << std::endl;
+        server.run();
+        g_server = nullptr;
+    }
+    catch (std::exception const & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
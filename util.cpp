@@ -1,7 +1,9 @@
 //
 // Created by Kuuba Puacz on 22/10/2024.
 //
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include "util.h"
 
 namespace java {
@@ -60,6 +62,17 @@ namespace java {
     }
 
 
+    std::vector<Game::Move> movesToCpp(JNIEnv *env, jobjectArray const &positions) {
+        // Moves are passed as the flat sequence of from and to positions
+        auto objects = readJavaArray(env, positions);
+        if (objects.size() % 2 != 0) throw std::runtime_error("Moves have to be given as pairs of from and to positions.");
+        auto moves = std::vector<Game::Move>();
+        for (auto i = 0; i + 1 < objects.size(); i += 2)
+            moves.push_back(Game::Move{positionToCpp(env, objects[i]), positionToCpp(env, objects[i + 1])});
+        return moves;
+    }
+
+
     ///////////////////////////////////////////////////////
     /// Conversions from C++ to Java
     ///////////////////////////////////////////////////////
@@ -102,6 +115,39 @@ namespace java {
         );
     }
 
+    jobjectArray moveToJava(JNIEnv * env, Game::Move const &move) {
+        return movesToJava(env, std::vector<Game::Move>{move});
+    }
+
+    jobjectArray movesToJava(JNIEnv * env, std::vector<Game::Move> const &moves) {
+        auto array = env->NewObjectArray(static_cast<jsize>(2 * moves.size()),
+                                         env->FindClass("main/GamePosition"), nullptr);
+        for (auto i = 0; i < moves.size(); i++) {
+            env->SetObjectArrayElement(array, 2 * i, positionToJava(env, moves[i].from));
+            env->SetObjectArrayElement(array, 2 * i + 1, positionToJava(env, moves[i].to));
+        }
+        return array;
+    }
+
+    jobject lineToJava(JNIEnv * env, Engine::Line const &line) {
+        auto cls = env->FindClass("main/GameAnalysisLine");
+        auto constructor = env->GetMethodID(cls, "<init>", "(I[Lmain/GamePosition;)V");
+        return env->NewObject(cls, constructor, static_cast<jint>(line.score), movesToJava(env, line.pv));
+    }
+
+    jobject annotationToJava(JNIEnv * env, Engine::Annotation const &annotation) {
+        auto cls = env->FindClass("main/GameAnnotation");
+        auto constructor = env->GetMethodID(cls, "<init>", "(ZIII[Lmain/GamePosition;)V");
+        return env->NewObject(
+             cls, constructor,
+             annotation.isCorrect ? JNI_TRUE : JNI_FALSE,
+             static_cast<jint>(annotation.bestScore),
+             static_cast<jint>(annotation.playedScore),
+             static_cast<jint>(annotation.loss),
+             moveToJava(env, annotation.best)
+        );
+    }
+
     std::vector<jobject> readJavaArray(JNIEnv * env, jobjectArray const &array) {
         auto objects = std::vector<jobject>();
         for (auto i = 0; i < env->GetArrayLength(array); i++) {
@@ -5,6 +5,7 @@
 #ifndef UTP_GAME_PROJECT_LOGIC_UTIL_H
 #define UTP_GAME_PROJECT_LOGIC_UTIL_H
 
+#include "Engine.h"
 #include "Game.h"
 #include <vector>
 #include <map>
@@ -24,6 +25,8 @@ namespace java {
     std::pair<int, int> positionToCpp(JNIEnv *env, jobject const &pos);
     Game::Player playerToCpp(JNIEnv *env, jobject const &player);
     Game::Tile tileToCpp(JNIEnv *env, jobject const &tile);
+    // Throws if the positions do not form whole moves.
+    std::vector<Game::Move> movesToCpp(JNIEnv *env, jobjectArray const &positions);
 
     ///////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////
@@ -32,6 +35,10 @@ namespace java {
     jobject tileToJava(JNIEnv *env, Game::Tile const &tile);
     jobject playerToJava(JNIEnv *env, Game::Player const & player);
     jobject resultsToJava(JNIEnv * env, Game::MoveResult const &results);
+    jobjectArray moveToJava(JNIEnv * env, Game::Move const &move);
+    jobjectArray movesToJava(JNIEnv * env, std::vector<Game::Move> const &moves);
+    jobject lineToJava(JNIEnv * env, Engine::Line const &line);
+    jobject annotationToJava(JNIEnv * env, Engine::Annotation const &annotation);
     std::vector<jobject> readJavaArray(JNIEnv * env, jobjectArray const &array);
 
 }